@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+// Differential check of AvrCore register blocks (Simulator::mcuQuantum):
+// the same program runs in two cores, one in block mode and one instruction
+// per step. After every block, cycles, PC, state and all RAM (including
+// CPU and I/O registers) must be the same in both.
+//
+// Usage: avrblock_check [firmware.hex...]
+//        Random programs are always checked, then each firmware file.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "avrcore.h"
+#include "simulator.h"
+
+#define RAM_SIZE  0x900
+#define PROG_SIZE 0x10000 // Words
+
+static bool runCheck( const char* name, const std::vector<uint16_t>& prog
+                    , const std::vector<uint8_t>& ram, long blocks )
+{
+    eMcu mcuBlock( RAM_SIZE, PROG_SIZE );
+    eMcu mcuStep(  RAM_SIZE, PROG_SIZE );
+    for( size_t i=0; i<prog.size() && i<PROG_SIZE; ++i ) mcuBlock.m_progMem[i] = mcuStep.m_progMem[i] = prog[i];
+    mcuBlock.m_ram = mcuStep.m_ram = ram;
+
+    AvrCore coreBlock( &mcuBlock );
+    AvrCore coreStep(  &mcuStep );
+
+    uint64_t cyclesBlock = 0, cyclesStep = 0, insts = 0;
+
+    for( long n=0; n<blocks; ++n )
+    {
+        Simulator::self()->setMcuQuantum( true );
+        coreBlock.runStep();
+        cyclesBlock += mcuBlock.cyclesDone;
+
+        Simulator::self()->setMcuQuantum( false );
+        while( cyclesStep < cyclesBlock && mcuStep.state() == mcuRunning ) // Sleeping Mcu doesn't run
+        {
+            coreStep.runStep();
+            cyclesStep += mcuStep.cyclesDone;
+            insts++;
+        }
+        if( cyclesStep != cyclesBlock || coreBlock.m_PC != coreStep.m_PC
+         || mcuBlock.state() != mcuStep.state() || mcuBlock.m_ram != mcuStep.m_ram )
+        {
+            printf("%s: MISMATCH after block %li: cycles %lu/%lu PC %X/%X state %i/%i\n", name, n
+                  , (unsigned long)cyclesBlock, (unsigned long)cyclesStep
+                  , coreBlock.m_PC, coreStep.m_PC, mcuBlock.state(), mcuStep.state() );
+
+            for( int i=0; i<RAM_SIZE; ++i )
+                if( mcuBlock.m_ram[i] != mcuStep.m_ram[i] )
+                    printf("  RAM[%03X] %02X/%02X\n", i, mcuBlock.m_ram[i], mcuStep.m_ram[i] );
+            return false;
+        }
+        if( mcuBlock.state() == mcuSleeping ) // No peripherals: wake up at once
+        {
+            mcuBlock.sleep( false );
+            mcuStep.sleep( false );
+        }
+    }
+    printf("%s: %li blocks, %lu instructions, %lu cycles OK\n", name, blocks
+          , (unsigned long)insts, (unsigned long)cyclesBlock );
+    return true;
+}
+
+static bool loadHex( const char* file, std::vector<uint16_t>& prog ) // Intel Hex
+{
+    std::ifstream in( file );
+    if( !in ) return false;
+
+    std::vector<uint8_t> bytes( PROG_SIZE*2, 0xFF );
+    uint32_t base = 0;
+    std::string line;
+    while( std::getline( in, line ) )
+    {
+        if( line.size() < 11 || line[0] != ':' ) continue;
+        auto hexByte = [&]( int i ){ return (uint8_t)strtoul( line.substr( 1+i*2, 2 ).c_str(), nullptr, 16 ); };
+
+        uint8_t  size = hexByte( 0 );
+        uint32_t addr = (hexByte( 1 ) << 8) | hexByte( 2 );
+        uint8_t  type = hexByte( 3 );
+        if( line.size() < 11u+size*2 ) return false;
+
+        if     ( type == 1 ) break;
+        else if( type == 2 ) base = ((hexByte( 4 ) << 8) | hexByte( 5 )) << 4;  // Extended Segment Address
+        else if( type == 4 ) base = ((hexByte( 4 ) << 8) | hexByte( 5 )) << 16; // Extended Linear Address
+        else if( type == 0 )
+            for( int i=0; i<size; ++i )
+                if( base+addr+i < bytes.size() ) bytes[base+addr+i] = hexByte( 4+i );
+    }
+    prog.resize( PROG_SIZE );
+    for( uint32_t i=0; i<PROG_SIZE; ++i ) prog[i] = bytes[2*i] | (bytes[2*i+1] << 8);
+    return true;
+}
+
+int main( int argc, char* argv[] )
+{
+    int errors = 0;
+
+    for( uint32_t seed=1; seed<=8; ++seed ) // Random programs, RAM and registers
+    {
+        std::mt19937 rng( seed );
+        std::vector<uint16_t> prog( 4096 );
+        for( uint16_t& word : prog ){
+            word = rng();
+            if( (word & 0xfe0e) == 0x9006 ) word = 0; // ELPM needs RAMPZ
+        }
+        std::vector<uint8_t> ram( RAM_SIZE );
+        for( uint8_t& byte : ram ) byte = rng();
+        ram[0x5E] = 0x04;                             // SPH: Stack inside RAM
+
+        std::string name = "random-"+std::to_string( seed );
+        if( !runCheck( name.c_str(), prog, ram, 200000 ) ) errors++;
+    }
+    // SLEEP followed by register instructions: block must end at SLEEP
+    std::vector<uint16_t> sleepProg = { 0x9588, 0xE010, 0xE021, 0x9513, 0xCFFB }; // sleep, ldi, ldi, inc, rjmp 0
+    if( !runCheck( "sleep", sleepProg, std::vector<uint8_t>( RAM_SIZE, 0 ), 1000 ) ) errors++;
+
+    for( int i=1; i<argc; ++i ) // Firmware files
+    {
+        std::vector<uint16_t> prog;
+        if( !loadHex( argv[i], prog ) )
+        {
+            printf("%s: can't load\n", argv[i] );
+            errors++;
+            continue;
+        }
+        std::vector<uint8_t> ram( RAM_SIZE, 0 );
+        if( !runCheck( argv[i], prog, ram, 1000000 ) ) errors++;
+    }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,181 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+// Minimal eMcu and McuCpu to build AvrCore without Qt or peripherals:
+// registers are plain RAM, interrupts and watchdog do nothing.
+
+#ifndef MCUCPU_H
+#define MCUCPU_H
+
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+typedef unsigned int uint;
+
+struct QDebugStub{ template <class T> QDebugStub& operator<<( const T& ){ return *this; } };
+#define qDebug() QDebugStub()
+
+#define STATUS(bit) (*m_STATUS & (1<<bit))
+
+enum mcuState_t{
+    mcuStopped=0,
+    mcuRunning,
+    mcuSleeping
+};
+
+struct Interrupts{ void retI(){} };
+
+class eMcu
+{
+    public:
+        eMcu( uint32_t ramSize, uint32_t progSize )
+        {
+            m_ram.resize( ramSize, 0 );
+            m_progMem.resize( progSize, 0 );
+        }
+
+        uint8_t readReg( uint16_t addr ) { return m_ram[addr]; }
+        void   writeReg( uint16_t addr, uint8_t v ) { m_ram[addr] = v; }
+
+        bool regExist( std::string ) { return false; } // No EIND or RAMPZ
+        uint8_t* getReg( std::string ) { return nullptr; }
+        uint16_t getRegAddress( std::string ) { return 0; }
+
+        bool isDebugging() { return false; }
+        void enableInterrupts( bool ){}
+        void sleep( bool s ) { m_state = s ? mcuSleeping : mcuRunning; }
+        void wdr(){}
+        Interrupts* interrupts() { return &m_interrupts; }
+        mcuState_t state() { return m_state; }
+
+        int cyclesDone = 0;
+        uint16_t m_regStart = 32;
+        mcuState_t m_state = mcuRunning;
+        Interrupts m_interrupts;
+
+        std::vector<uint8_t>  m_ram;
+        std::vector<uint16_t> m_progMem;
+};
+
+class McuCpu
+{
+    public:
+        McuCpu( eMcu* mcu )
+        {
+            m_mcu = mcu;
+            m_dataMem    = mcu->m_ram.data();
+            m_dataMemEnd = mcu->m_ram.size()-1;
+            m_progMem    = mcu->m_progMem.data();
+            m_progSize   = mcu->m_progMem.size();
+            m_progAddrSize = 2;
+            m_regEnd  = 0xFF;
+            m_STATUS  = &m_dataMem[0x5F];
+            m_spl     = &m_dataMem[0x5D];
+            m_sph     = &m_dataMem[0x5E];
+            m_spPre   = false;
+            m_spInc   = -1;
+            m_PC = 0;
+        }
+        virtual ~McuCpu(){}
+
+        virtual void runStep(){}
+        virtual void flashChanged( uint32_t ){}
+
+        eMcu*     m_mcu;
+        uint8_t   m_retCycles;
+        uint32_t  m_PC;
+        uint32_t  m_RET_ADDR;
+        uint8_t*  m_STATUS;
+        uint8_t*  m_spl;
+        uint8_t*  m_sph;
+        bool      m_spPre;
+        int       m_spInc;
+        uint8_t*  m_dataMem;
+        uint32_t  m_dataMemEnd;
+        uint16_t* m_progMem;
+        uint32_t  m_progSize;
+        uint8_t   m_progAddrSize;
+        uint16_t  m_regEnd;
+
+        void clear_S_Bit( uint8_t bit) { *m_STATUS &= ~(1<<bit); }
+        void set_S_Bit( uint8_t bit )  { *m_STATUS |=   1<<bit; }
+        void write_S_Bit( uint8_t bit, bool val )
+        {
+            if( val ) *m_STATUS |=   1<<bit;
+            else      *m_STATUS &= ~(1<<bit);
+        }
+
+        uint8_t GET_RAM( uint16_t addr )
+        {
+            if( addr >= m_mcu->m_regStart && addr <= m_regEnd ) return m_mcu->readReg( addr );
+            if( addr <= m_dataMemEnd ) return m_dataMem[addr];
+            return 0;
+        }
+        void SET_RAM( uint16_t addr, uint8_t v )
+        {
+            if( addr >= m_mcu->m_regStart && addr <= m_regEnd ) m_mcu->writeReg( addr, v );
+            else if( addr <= m_dataMemEnd ) m_dataMem[addr] = v;
+        }
+        void SET_REG16_LH( uint16_t addr, uint16_t val )
+        {
+            m_mcu->writeReg( addr, val );
+            m_mcu->writeReg( addr+1, val>>8 );
+        }
+        void SET_REG16_HL( uint16_t addr, uint16_t val )
+        {
+            m_mcu->writeReg( addr+1, val>>8 );
+            m_mcu->writeReg( addr , val );
+        }
+
+        uint16_t GET_SP()
+        {
+            uint16_t sp = *m_spl;
+            if( m_sph ) sp |= (*m_sph << 8);
+            return sp;
+        }
+        void SET_SP( uint16_t sp )
+        {
+            *m_spl = sp & 0xFF;
+            if( m_sph ) *m_sph = (sp>>8) & 0xFF;
+        }
+        void PUSH_STACK( uint32_t addr )
+        {
+            uint16_t sp = GET_SP();
+            if( m_spPre ) sp += m_spInc;
+            for( int i=0; i<m_progAddrSize; i++, addr>>=8, sp += m_spInc ) SET_RAM( sp, addr & 0xFF );
+            if( m_spPre ) sp -= m_spInc;
+            SET_SP( sp );
+        }
+        uint32_t POP_STACK()
+        {
+            uint16_t sp = GET_SP();
+            uint32_t res = 0;
+            if( !m_spPre ) sp -= m_spInc;
+            for( int i=0; i<m_progAddrSize; i++, sp -= m_spInc ) res = (res<<8) | GET_RAM( sp );
+            if( !m_spPre ) sp += m_spInc;
+            SET_SP( sp );
+            return res;
+        }
+        void PUSH_STACK8( uint8_t v )
+        {
+            uint16_t sp = GET_SP();
+            if( m_spPre ) sp += m_spInc;
+            SET_RAM( sp, v );
+            if( !m_spPre ) sp += m_spInc;
+            SET_SP( sp );
+        }
+        uint8_t POP_STACK8()
+        {
+            uint16_t sp = GET_SP();
+            if( !m_spPre ) sp -= m_spInc;
+            uint8_t res = GET_RAM( sp );
+            if( m_spPre ) sp -= m_spInc;
+            SET_SP( sp );
+            return res;
+        }
+};
+
+#endif
@@ -0,0 +1,24 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+// Declarations needed by avrsleep.h (included by avrcore.cpp, not used).
+
+#ifndef MCUSLEEP_H
+#define MCUSLEEP_H
+
+#include "mcucpu.h"
+
+class QString;
+class Interrupt;
+
+class McuSleep
+{
+    public:
+        virtual ~McuSleep(){}
+        virtual void initialize(){}
+        virtual void configureA( uint8_t ){}
+};
+
+#endif
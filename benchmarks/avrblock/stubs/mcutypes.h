@@ -0,0 +1,11 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef MCUTYPES_H
+#define MCUTYPES_H
+
+struct regBits_t{ uint8_t bit0; uint8_t mask; uint8_t* reg; };
+
+#endif
@@ -0,0 +1,23 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+// Simulator settings used by AvrCore: block mode is set by the check.
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+class Simulator
+{
+    public:
+ static Simulator* self() { static Simulator sim; return &sim; }
+
+        bool mcuQuantum() { return m_mcuQuantum; }
+        void setMcuQuantum( bool q ) { m_mcuQuantum = q; }
+
+    private:
+        bool m_mcuQuantum = false;
+};
+
+#endif
@@ -0,0 +1,19 @@
+; Compiler: avra
+; I/O heavy loop for register access benchmarks:
+; toggle PORTB and PORTD, read PINB, write and read GPIOR0 (no watcher).
+
+.include "m328Pdef.inc"
+
+.org 0
+        ldi  r16, 0xFF
+        out  DDRB, r16
+        out  DDRD, r16
+        ldi  r17, 0x00
+loop:
+        out  PORTB, r17
+        out  PORTD, r17
+        in   r18, PINB
+        out  GPIOR0, r18
+        in   r19, GPIOR0
+        com  r17
+        rjmp loop
@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+// Simulator event queue: binary heap (EventQueue) vs old sorted list.
+// For N pending events, times add/pop (steady state: every popped event
+// schedules a new one) and cancel/add (element rescheduled before firing).
+// Also checks that both queues run events in exactly the same order.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "eventqueue.h"
+
+struct Event
+{
+    uint64_t eventTime = 0;
+    uint64_t eventSeq  = 0;
+    int      eventIdx  = -1;
+    Event*   nextEvent = nullptr;
+};
+
+// Old Simulator event list (before binary heap), same code.
+class EventList
+{
+    public:
+        bool empty() const { return m_firstEvent == nullptr; }
+        Event* first() const { return m_firstEvent; }
+
+        void insert( Event* el, uint64_t time )
+        {
+            Event* last  = nullptr;
+            Event* event = m_firstEvent;
+
+            while( event ){
+                if( time <= event->eventTime ) break; // Insert event here
+                last  = event;
+                event = event->nextEvent;
+            }
+            el->eventTime = time;
+
+            if( last ) last->nextEvent = el;
+            else       m_firstEvent = el; // List was empty or insert First
+
+            el->nextEvent = event;
+        }
+
+        void remove( Event* el )
+        {
+            if( el->eventTime == 0 ) return;
+            Event* event = m_firstEvent;
+            Event* last  = nullptr;
+            Event* next  = nullptr;
+            el->eventTime = 0;
+
+            while( event ){
+                next = event->nextEvent;
+                if( el == event )
+                {
+                    if( last ) last->nextEvent = next;
+                    else       m_firstEvent = next;
+                    event->nextEvent = nullptr;
+                }
+                else last = event;
+                event = next;
+        }   }
+
+        void removeFirst()
+        {
+            Event* event = m_firstEvent;
+            m_firstEvent = event->nextEvent;
+            event->nextEvent = nullptr;
+            event->eventTime = 0;
+        }
+
+    private:
+        Event* m_firstEvent = nullptr;
+};
+
+struct Heap : EventQueue<Event>
+{
+    void removeFirst() { removeAt( 0 ); }
+};
+
+static uint64_t s_checksum = 0;
+
+// Initial events added latest first: no list walk, setup is not timed.
+template <class Q>
+static void fill( Q& q, std::vector<Event>& events, std::mt19937& rng )
+{
+    std::vector<uint64_t> times( events.size() );
+    for( uint64_t& t : times ) t = 1+rng()%1000;
+    std::sort( times.begin(), times.end(), std::greater<uint64_t>() );
+    for( size_t i=0; i<events.size(); ++i ) q.insert( &events[i], times[i] );
+}
+
+// Delays in a small range, so many events share the same time (ties).
+template <class Q>
+static double addPop( int n, int ops, uint32_t seed )
+{
+    std::vector<Event> events( n );
+    std::mt19937 rng( seed );
+    Q q;
+    uint64_t now = 0;
+    fill( q, events, rng );
+
+    auto t0 = std::chrono::steady_clock::now();
+    for( int i=0; i<ops; ++i )
+    {
+        Event* e = q.first();
+        now = e->eventTime;
+        q.removeFirst();
+        s_checksum = s_checksum*31 + (e - events.data());
+        q.insert( e, now+1+rng()%1000 );
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>( t1-t0 ).count()/ops;
+}
+
+template <class Q>
+static double cancelAdd( int n, int ops, uint32_t seed )
+{
+    std::vector<Event> events( n );
+    std::mt19937 rng( seed );
+    Q q;
+    fill( q, events, rng );
+
+    auto t0 = std::chrono::steady_clock::now();
+    for( int i=0; i<ops; ++i )
+    {
+        Event* e = &events[rng()%n];
+        q.remove( e );
+        q.insert( e, 1+rng()%1000 );
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    while( !q.empty() ){
+        s_checksum = s_checksum*31 + (q.first() - events.data());
+        q.removeFirst();
+    }
+    return std::chrono::duration<double, std::nano>( t1-t0 ).count()/ops;
+}
+
+int main()
+{
+    const int sizes[] = { 10, 100, 1000, 10000, 100000 };
+    int errors = 0;
+
+    printf("     N   add/pop list  add/pop heap   cancel/add list  cancel/add heap   (ns/op)\n");
+    for( int n : sizes )
+    {
+        int ops = 20000000/n; // Keep old list runs bounded
+        if( ops > 1000000 ) ops = 1000000;
+        if( ops < 200     ) ops = 200;
+
+        s_checksum = 0;
+        double listAP = addPop<EventList>( n, ops, n );
+        uint64_t listSum = s_checksum;
+        s_checksum = 0;
+        double heapAP = addPop<Heap>( n, ops, n );
+        if( s_checksum != listSum ) { printf("N=%i add/pop: order mismatch\n", n ); errors++; }
+
+        s_checksum = 0;
+        double listCA = cancelAdd<EventList>( n, ops, n );
+        listSum = s_checksum;
+        s_checksum = 0;
+        double heapCA = cancelAdd<Heap>( n, ops, n );
+        if( s_checksum != listSum ) { printf("N=%i cancel/add: order mismatch\n", n ); errors++; }
+
+        printf("%6i  %12.1f  %12.1f  %15.1f  %15.1f\n", n, listAP, heapAP, listCA, heapCA );
+    }
+    if( errors ) printf("FAILED: heap order differs from old list\n");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+#!/bin/bash
+# I/O heavy AVR benchmark for flat register signal tables (user-006):
+# atmega328 at 16 MHz toggling PORTB/PORTD, reading PINB and
+# writing/reading GPIOR0 in a tight loop (circuits/avr_io).
+# Builds SimulIDE without and with the change and runs both.
+#
+# Usage: avr_io.sh [sim_time_s] [runs]
+
+source "$(dirname "$0")/bench_common.sh"
+
+TIME=${1:-5}
+RUNS=${2:-5}
+CIRC="$REPO_DIR/benchmarks/circuits/avr_io/avr_io.sim1"
+
+NEW=$(rev_of user-006)
+HEADLESS=$(rev_of user-008)
+[ -n "$NEW" ] && [ -n "$HEADLESS" ] || { echo "Commits not found" >&2; exit 1; }
+
+EXE_OLD=$(build_simulide avr_io-without "$NEW^" "$HEADLESS") || exit 1
+EXE_NEW=$(build_simulide avr_io-with    "$NEW"  "$HEADLESS") || exit 1
+
+T_OLD=$(best_of "$RUNS" run_headless "$EXE_OLD" "$CIRC" "$TIME") || exit 1
+T_NEW=$(best_of "$RUNS" run_headless "$EXE_NEW" "$CIRC" "$TIME") || exit 1
+
+echo "avr_io: $TIME s simulated, best of $RUNS runs"
+echo "  without flat tables: $T_OLD ms"
+echo "  with flat tables:    $T_NEW ms"
@@ -0,0 +1,81 @@
+#!/bin/bash
+# Helpers for benchmarks run through "simulide --headless".
+# Source it from benchmark scripts.
+#
+# SIMULIDE_BENCH_DIR: folder for builds, settings and logs (default /tmp/simulide_bench)
+
+REPO_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)
+BENCH_DIR=${SIMULIDE_BENCH_DIR:-/tmp/simulide_bench}
+mkdir -p "$BENCH_DIR"
+
+# Commit of a backlog request (not its review fixes): rev_of <request_id>
+rev_of()
+{
+    git -C "$REPO_DIR" log --format='%H %s' | grep -F "[$1] " | grep -vF "[$1] fix:" | tail -n1 | cut -d' ' -f1
+}
+
+# Build SimulIDE at a git revision in a worktree, prints executable path.
+# Extra commits are applied on top if the revision doesn't have them,
+# e.g. the headless runner for revisions older than it.
+# build_simulide <name> <rev> [commit...]
+build_simulide()
+{
+    local name=$1 rev=$2; shift 2
+    local hash
+    hash=$(git -C "$REPO_DIR" rev-parse --short "$rev") || return 1
+    local tree="$BENCH_DIR/$name-$hash"
+
+    local exe
+    exe=$(find "$tree/build_XX/executables" -name simulide -type f -perm -u+x 2>/dev/null | head -n1)
+    if [ -n "$exe" ]; then echo "$exe"; return 0; fi
+
+    git -C "$REPO_DIR" worktree remove --force "$tree" >/dev/null 2>&1
+    rm -rf "$tree"
+    git -C "$REPO_DIR" worktree add --detach "$tree" "$hash" >&2 || return 1
+
+    for commit in "$@"; do
+        git -C "$tree" merge-base --is-ancestor "$commit" HEAD && continue
+        git -C "$tree" cherry-pick --no-commit "$commit" >&2 || return 1
+    done
+    ( cd "$tree/build_XX" && qmake && make -j"$(nproc)" ) >&2 || return 1
+
+    exe=$(find "$tree/build_XX/executables" -name simulide -type f -perm -u+x | head -n1)
+    [ -n "$exe" ] && echo "$exe"
+}
+
+# Run a circuit headless with private settings, prints wall time in ms.
+# Settings are "key=value" pairs of the [Simulator] group, e.g. mcuQuantum=true
+# Output of the last run is in $BENCH_DIR/last_run.log
+# HEADLESS_ARGS: extra arguments for simulide, e.g. --dump=file
+# run_headless <simulide> <circuit|folder> <time_s> [key=value...]
+run_headless()
+{
+    local exe=$1 circ=$2 time=$3; shift 3
+    local home="$BENCH_DIR/settings"
+    local config="$home/$(basename "$exe")"   # QStandardPaths::DataLocation
+    rm -rf "$home"
+    mkdir -p "$config"
+    { echo "[Simulator]"; for setting in "$@"; do echo "$setting"; done; } > "$config/simulide.ini"
+
+    local t0 t1
+    t0=$(date +%s%N)
+    if ! XDG_DATA_HOME="$home" "$exe" --headless "$circ" "$time" --jobs=1 $HEADLESS_ARGS > "$BENCH_DIR/last_run.log" 2>&1
+    then
+        cat "$BENCH_DIR/last_run.log" >&2
+        return 1
+    fi
+    t1=$(date +%s%N)
+    echo $(( (t1-t0)/1000000 ))
+}
+
+# Lowest time of several runs: best_of <runs> <command...>
+best_of()
+{
+    local runs=$1; shift
+    local best="" t i
+    for (( i=0; i<runs; i++ )); do
+        t=$("$@") || return 1
+        if [ -z "$best" ] || [ "$t" -lt "$best" ]; then best=$t; fi
+    done
+    echo "$best"
+}
@@ -0,0 +1,27 @@
+#!/bin/bash
+# mcs-51 core benchmark for the fixed inline operand queue (user-024):
+# 8051 examples at 12 MHz run through the headless runner.
+# Builds SimulIDE without and with the change and runs both.
+#
+# Usage: i51_timing.sh [sim_time_s] [runs]
+
+source "$(dirname "$0")/bench_common.sh"
+
+TIME=${1:-5}
+RUNS=${2:-5}
+EXAMPLES="$REPO_DIR/resources/examples/Micro/mcs-51"
+
+NEW=$(rev_of user-024)
+[ -n "$NEW" ] || { echo "Commit not found" >&2; exit 1; }
+
+EXE_OLD=$(build_simulide i51-without "$NEW^") || exit 1
+EXE_NEW=$(build_simulide i51-with    "$NEW" ) || exit 1
+
+echo "mcs-51: $TIME s simulated, best of $RUNS runs (ms)"
+echo "circuit                    without      with"
+for circ in "$EXAMPLES/mcs-51_blink/mcs-51_test.sim1" "$EXAMPLES/mcs-51_switch/mcs-51_test.sim1"; do
+    t_old=$(best_of "$RUNS" run_headless "$EXE_OLD" "$circ" "$TIME") || exit 1
+    t_new=$(best_of "$RUNS" run_headless "$EXE_NEW" "$circ" "$TIME") || exit 1
+
+    printf "%-24s  %8i  %8i\n" "$(basename "$(dirname "$circ")")" "$t_old" "$t_new"
+done
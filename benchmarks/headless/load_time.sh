@@ -0,0 +1,35 @@
+#!/bin/bash
+# Circuit load time benchmark for component lookup by uid (user-019):
+# generated circuits of increasing size loaded through the headless
+# runner, with a very short simulation so loading dominates.
+# Builds SimulIDE without and with the change and runs both.
+#
+# Usage: load_time.sh [runs]
+
+source "$(dirname "$0")/bench_common.sh"
+
+RUNS=${1:-3}
+TIME=1e-6
+SECTIONS=32
+
+NEW=$(rev_of user-019)
+[ -n "$NEW" ] || { echo "Commit not found" >&2; exit 1; }
+
+EXE_OLD=$(build_simulide load-without "$NEW^") || exit 1
+EXE_NEW=$(build_simulide load-with    "$NEW" ) || exit 1
+
+CIRC_DIR="$BENCH_DIR/load_time"
+mkdir -p "$CIRC_DIR"
+
+echo "Load and $TIME s simulated, best of $RUNS runs (ms)"
+echo "  items   without      with"
+for groups in 1 4 16 64 256; do
+    circ="$CIRC_DIR/rc_${groups}x${SECTIONS}.sim1"
+    python3 "$REPO_DIR/benchmarks/tools/gen_rc_groups.py" "$groups" "$SECTIONS" "$circ" || exit 1
+    items=$(grep -c "<item " "$circ")
+
+    t_old=$(best_of "$RUNS" run_headless "$EXE_OLD" "$circ" "$TIME") || exit 1
+    t_new=$(best_of "$RUNS" run_headless "$EXE_NEW" "$circ" "$TIME") || exit 1
+
+    printf "%7i  %8i  %8i\n" "$items" "$t_old" "$t_new"
+done
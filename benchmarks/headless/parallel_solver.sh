@@ -0,0 +1,37 @@
+#!/bin/bash
+# Parallel group solver benchmark (user-014): circuits of 1 to 64
+# independent RC ladders, solved serially and in parallel threads.
+# Also checks that both give bit-identical node voltages.
+#
+# Usage: parallel_solver.sh [simulide] [sim_time_s] [runs] [sections]
+#        Without simulide executable, current tree (HEAD) is built.
+
+source "$(dirname "$0")/bench_common.sh"
+
+EXE=${1:-$(build_simulide head HEAD)} || exit 1
+TIME=${2:-0.01}
+RUNS=${3:-3}
+SECTIONS=${4:-32}
+
+CIRC_DIR="$BENCH_DIR/rc_groups"
+mkdir -p "$CIRC_DIR"
+errors=0
+
+echo "RC ladders of $SECTIONS sections, $TIME s simulated, best of $RUNS runs (ms)"
+echo "groups   serial  parallel  voltages"
+for groups in 1 2 4 8 16 32 64; do
+    circ="$CIRC_DIR/rc_${groups}x${SECTIONS}.sim1"
+    python3 "$REPO_DIR/benchmarks/tools/gen_rc_groups.py" "$groups" "$SECTIONS" "$circ" || exit 1
+
+    t_ser=$(best_of "$RUNS" run_headless "$EXE" "$circ" "$TIME" parallelSolver=false) || exit 1
+    t_par=$(best_of "$RUNS" run_headless "$EXE" "$circ" "$TIME" parallelSolver=true)  || exit 1
+
+    HEADLESS_ARGS="--dump=$CIRC_DIR/serial.txt"   run_headless "$EXE" "$circ" "$TIME" parallelSolver=false >/dev/null || exit 1
+    HEADLESS_ARGS="--dump=$CIRC_DIR/parallel.txt" run_headless "$EXE" "$circ" "$TIME" parallelSolver=true  >/dev/null || exit 1
+
+    if [ -s "$CIRC_DIR/serial.txt" ] && cmp -s "$CIRC_DIR/serial.txt" "$CIRC_DIR/parallel.txt"; then check="identical"
+    else check="DIFFERENT"; errors=$((errors+1)); fi
+
+    printf "%6i  %7i  %8i  %s\n" "$groups" "$t_ser" "$t_par" "$check"
+done
+exit $(( errors > 0 ))
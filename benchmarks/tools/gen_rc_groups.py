@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# Generate a circuit of independent RC ladders for solver benchmarks.
+#
+# Each group is a Clock driving a ladder of resistors with capacitors to
+# ground, so groups share no node and all change at the same time.
+# Circuit size is groups * (sections+1) nodes.
+#
+# Usage: gen_rc_groups.py <groups> <sections> <out.sim1> [clock_Hz]
+
+import sys
+
+def item( itemtype, cid, x, y, extra="" ):
+    return ('<item itemtype="%s" CircId="%s" mainComp="false" Show_id="false" Show_Val="false" '
+            'Pos="%i,%i" rotation="0" hflip="1" vflip="1" label="%s" idLabPos="-16,-24" labelrot="0" '
+            'valLabPos="0,0" valLabRot="0" %s/>\n\n' % ( itemtype, cid, x, y, cid, extra ))
+
+def node( cid, x, y ):
+    return '<item itemtype="Node" CircId="%s" mainComp="false" Pos="%i,%i" />\n\n' % ( cid, x, y )
+
+class Circuit:
+    def __init__( self ):
+        self.items = []
+        self.wires = []
+        self.uid = 0
+
+    def newId( self, name ):
+        self.uid += 1
+        return "%s-%i" % ( name, self.uid )
+
+    def connect( self, start, end, x0, y0, x1, y1 ):
+        self.wires.append( '<item itemtype="Connector" uid="%s" startpinid="%s" endpinid="%s" pointList="%i,%i,%i,%i" />\n\n'
+                           % ( self.newId("Connector"), start, end, x0, y0, x1, y1 ))
+
+def rcGroup( circ, group, sections, freq ):
+    y = group*64
+    clock = circ.newId("Clock")
+    circ.items.append( item("Clock", clock, 0, y, 'Out="true" Running="true" Voltage="5 V" Freq="%g Hz" Always_On="true" ' % freq ))
+
+    prevPin = clock+"-outnod"
+    for k in range( sections ):
+        x = 48 + k*64
+        res = circ.newId("Resistor")
+        cap = circ.newId("Capacitor")
+        gnd = circ.newId("Ground")
+        circ.items.append( item("Resistor", res, x, y, 'ShowProp="Resistance" Resistance="1 kΩ" ' ))
+        circ.items.append( item("Capacitor", cap, x+32, y+24, 'ShowProp="Capacitance" Capacitance="100 nF" Resistance="1e-06 Ω" InitVolt="0 V" ReaStep="0 ns" ' ))
+        circ.items.append( item("Ground", gnd, x+32, y+48 ))
+        circ.connect( prevPin, res+"-lPin", x-24, y, x-16, y )
+        circ.connect( cap+"-rPin", gnd+"-Gnd", x+32, y+40, x+32, y+48 )
+
+        if k == sections-1:                      # Last section: no junction needed
+            circ.connect( res+"-rPin", cap+"-lPin", x+16, y, x+32, y+8 )
+            break
+        nod = circ.newId("Node")
+        circ.items.append( node( nod, x+32, y ))
+        circ.connect( res+"-rPin", nod+"-0", x+16, y, x+32, y )
+        circ.connect( nod+"-1", cap+"-lPin", x+32, y, x+32, y+8 )
+        prevPin = nod+"-2"
+
+def main():
+    if len( sys.argv ) < 4:
+        print("Usage: gen_rc_groups.py <groups> <sections> <out.sim1> [clock_Hz]")
+        return 2
+    groups   = int( sys.argv[1] )
+    sections = int( sys.argv[2] )
+    freq     = float( sys.argv[4] ) if len( sys.argv ) > 4 else 1000
+
+    circ = Circuit()
+    for g in range( groups ): rcGroup( circ, g, sections, freq )
+
+    with open( sys.argv[3], "w", encoding="utf-8" ) as f:
+        f.write('<circuit version="" rev="2224" stepSize="1000000" stepsPS="1000000" NLsteps="100000" reaStep="1000000" animate="0" >\n\n')
+        f.writelines( circ.items )
+        f.writelines( circ.wires )
+        f.write('</circuit>\n')
+    return 0
+
+if __name__ == "__main__":
+    sys.exit( main() )
@@ -13,6 +13,7 @@ LaChannel::LaChannel( LAnalizer* la, QString id )
          : DataChannel( la, id )
 {
     m_analizer = la;
+    m_capture  = nullptr;
     m_lastCond = C_NONE;
 }
 LaChannel::~LaChannel(){ }
@@ -77,6 +78,8 @@ void LaChannel::addReading( double v )
     if( ++m_bufferCounter >= m_buffer.size() ) m_bufferCounter = 0;
     m_buffer[m_bufferCounter] = v;
     m_time[m_bufferCounter] = simTime;
+
+    if( m_capture ) m_capture->addSample( simTime, m_channel, v );
 }
 
 void LaChannel::voltChanged()
@@ -39,6 +39,7 @@ class LaChannel : public DataChannel
         QMap<int, eNode*> m_busNodes;
 
         LAnalizer* m_analizer;
+        DataCapture* m_capture;
 };
 
 #endif
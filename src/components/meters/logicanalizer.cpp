@@ -78,6 +78,7 @@ LAnalizer::LAnalizer( QString type, QString id )
         m_dataWidget->setColor( i, m_color[i%4] );
     }
     m_updtCount = 0;
+    m_stream = false;
     m_thresholdR = 0;
     m_thresholdF = 0;
 
@@ -98,6 +99,9 @@ LAnalizer::LAnalizer( QString type, QString id )
 
         new BoolProp<LAnalizer>("AutoExport", tr("Export at pause"),""
                                , this, &LAnalizer::autoExport, &LAnalizer::setAutoExport ),
+
+        new BoolProp<LAnalizer>("Stream", tr("Stream to disk"),""
+                               , this, &LAnalizer::stream, &LAnalizer::setStream ),
     },0} );
 
     addPropGroup( { "Hidden1", {
@@ -121,6 +125,18 @@ LAnalizer::~LAnalizer()
     delete m_laWidget;
 }
 
+void LAnalizer::initialize()
+{
+    PlotBase::initialize();
+
+    DataCapture* capture = nullptr;
+    if( !Simulator::self()->isRunning() ) m_capture.stop(); // Simulation stopped: end writer, keep file for Export
+    else if( m_stream && m_capture.open() ) capture = &m_capture;
+    else m_capture.close();
+
+    for( int i=0; i<8; ++i ) static_cast<LaChannel*>( m_channel[i] )->m_capture = capture;
+}
+
 void LAnalizer::updateStep()
 {
     if( !Simulator::self()->isPaused() )
@@ -213,6 +229,12 @@ QString LAnalizer::timPos()
     return QString::number( m_timePos );
 }
 
+void LAnalizer::setStream( bool s ) // Applied at Simulation start
+{
+    m_stream = s;
+    if( !s && !Simulator::self()->isRunning() ) m_capture.close(); // Discard previous capture
+}
+
 void LAnalizer::setTimPos( QString tp )
 {
     setTimePos( tp.toLongLong() );
@@ -325,6 +347,13 @@ void LAnalizer::dumpData( const QString &fn )
     QTextStream out( &file );
     out.setLocale( QLocale::C );
 
+    if( m_stream && m_capture.isOpen() ) // Export full capture from disk
+    {
+        dumpCapture( out, identifiers );
+        file.close();
+        return;
+    }
+
     QMultiMap<uint64_t, sample_t> samples; // collect timing data, use QMap to implicitely sort it
 
     uint64_t startTime = m_display->startTime();
@@ -401,6 +430,62 @@ void LAnalizer::dumpData( const QString &fn )
     file.close();
 }
 
+void LAnalizer::dumpCapture( QTextStream& out, QChar* identifiers )
+{
+    uint64_t endTime = m_display->endTime()+m_timePos;
+
+    bool connected[8];
+    QString varDef;
+    QString dumpVars = "\n$dumpvars\n";
+
+    for( uint ch=0; ch<8; ++ch )
+    {
+        connected[ch] = m_channel[ch]->m_connected;
+        if( !connected[ch] ) continue;
+
+        QString name = m_channel[ch]->getChName();             // Get channel name
+        if( name.isEmpty() ) name = "D"+QString::number( ch ); // If name is empty set name = Dn
+
+        varDef += "$var wire 1 " + QString( identifiers[ch] )+" "+name+" $end\n";
+        dumpVars += "0"+QString( identifiers[ch] )+"\n"; // Channels start Low at Simulation start
+    }
+    dumpVars += "$end\n";
+
+    out <<"$timescale "<< m_timeStep <<"ps $end"<< endl<< endl;
+    out << varDef;
+    out << endl <<"$enddefinitions $end"<< endl;
+    out << dumpVars;
+
+    m_capture.flush();
+
+    uint64_t timeStamp = 0;
+    bool first = true;
+    std::vector<capSample_t> samples;
+
+    int chunks = m_capture.chunks();
+    for( int i=0; i<chunks; ++i ) // Samples in file are already sorted by time
+    {
+        if( !m_capture.readChunk( i, &samples ) ) break;
+
+        for( const capSample_t& sample : samples )
+        {
+            if( sample.time == 0 ) continue;      // Initial values already in $dumpvars
+            if( sample.time > endTime ) { i = chunks; break; }
+            if( !connected[sample.channel] ) continue;
+
+            uint64_t time = sample.time/m_timeStep;
+            if( first || time != timeStamp )
+            {
+                first = false;
+                timeStamp = time;
+                out << endl <<"#"<< timeStamp;
+            }
+            out <<" "<< sample.value <<identifiers[sample.channel];
+        }
+    }
+    out << endl <<"#"<< timeStamp+1; // last time stamp
+}
+
 uint64_t LAnalizer::getGcd( uint64_t a, uint64_t b )  // Greatest Common Denominator
 {
     uint64_t h;
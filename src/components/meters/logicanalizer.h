@@ -7,11 +7,13 @@
 #define LANALIZER_H
 
 #include "plotbase.h"
+#include "datacapture.h"
 
 class LibraryItem;
 class LaChannel;
 class LaWidget;
 class DataLaWidget;
+class QTextStream;
 
 struct sample_t{
     double value;
@@ -27,6 +29,7 @@ class LAnalizer : public PlotBase
  static Component* construct( QString type, QString id );
  static LibraryItem* libraryItem();
 
+        virtual void initialize() override;
         virtual void updateStep() override;
 
         virtual QString timPos() override;
@@ -54,6 +57,9 @@ class LAnalizer : public PlotBase
         double thresholdF() { return m_thresholdF; }
         void setThresholdF( double thr );
 
+        bool stream() { return m_stream; }
+        void setStream( bool s );
+
         QString busStr();
         void setBusStr( QString b );
 
@@ -68,6 +74,8 @@ class LAnalizer : public PlotBase
     private:
         uint64_t getGcd( uint64_t a, uint64_t b ); // greatest Common Denominator
 
+        void dumpCapture( QTextStream& out, QChar* identifiers );
+
         double m_voltDiv;
         double m_thresholdR;
         double m_thresholdF;
@@ -76,6 +84,9 @@ class LAnalizer : public PlotBase
 
         int64_t m_timePos;
 
+        bool m_stream;
+        DataCapture m_capture; // All samples since Simulation start if m_stream
+
         LaWidget*  m_laWidget;
         DataLaWidget* m_dataWidget;
 };
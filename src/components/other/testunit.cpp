@@ -3,6 +3,7 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDebug>
 #include <math.h>
 
 #include "testunit.h"
@@ -101,6 +102,7 @@ void TestUnit::runEvent()
 
         if( ++m_outValue < (uint)m_steps )
             Simulator::self()->addEvent( m_interval, this );
+        else if( BatchTest::isHeadless() ) checkSamples(); // No GUI updates
         else m_changed = true;
     }else{
         m_read = true;
@@ -134,6 +136,23 @@ void TestUnit::createTable()
     m_truthTable->show();
 }
 
+void TestUnit::checkSamples() // Compare samples with Truth table without TruthTable widget
+{
+    if( m_truthT.empty() ) // Not testing, as in TruthTable::setup()
+    {
+        qDebug() << "Test Unit without Truth table:" << getUid();
+        BatchTest::testCompleted( this, true );
+        return;
+    }
+    bool testOk = (m_truthT.size() == m_samples.size());
+
+    uint mask = (1<<m_inPin.size())-1;
+    for( uint i=0; testOk && i<m_samples.size(); ++i )
+        if( (m_samples[i] & mask) != (m_truthT[i] & mask) ) testOk = false;
+
+    BatchTest::testCompleted( this, testOk );
+}
+
 void TestUnit::save()
 {
     m_truthT = m_samples;
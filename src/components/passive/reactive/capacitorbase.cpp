@@ -40,6 +40,30 @@ CapacitorBase::CapacitorBase( QString type, QString id )
 }
 CapacitorBase::~CapacitorBase(){}
 
+double CapacitorBase::updtRes()
+{
+    switch( m_stepMethod ){
+        case reactEuler:       return m_tStep/m_capacitance;
+        case reactTrapezoidal: return m_tStep/(2*m_capacitance);
+        case reactGear2:{
+            double w = gearRatio();
+            return m_tStep*(1+w)/((1+2*w)*m_capacitance);
+    }   }
+    return m_tStep/m_capacitance;
+}
+
+double CapacitorBase::updtCurr() // Companion current source from last step state
+{
+    switch( m_stepMethod ){
+        case reactEuler:       return m_volt*m_admit;
+        case reactTrapezoidal: return m_volt*m_admit + m_curr;
+        case reactGear2:{
+            double w = gearRatio();
+            return m_capacitance/m_tStep*( (1+w)*m_volt - w*w/(1+w)*m_state[1] );
+    }   }
+    return m_volt*m_admit;
+}
+
 void CapacitorBase::setCurrentValue( double c )
 {
     m_capacitance = c;
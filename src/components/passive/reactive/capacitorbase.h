@@ -17,8 +17,8 @@ class CapacitorBase : public Reactive
         virtual void setCurrentValue( double c ) override;
 
     protected:
-        virtual double updtRes()  override { return m_tStep/m_capacitance; }
-        virtual double updtCurr() override { return m_volt*m_admit; }
+        virtual double updtRes()  override;
+        virtual double updtCurr() override;
 
         double m_capacitance;
 };
@@ -36,6 +36,8 @@ Inductor::Inductor( QString type, QString id )
     m_pin[1]->setLength( 4 );
 
     m_value = m_inductance = 1; // H
+    m_absTol = 1e-6;            // A
+    m_srcKeep = 1;
 
     addPropGroup( { tr("Main"), {
         new DoubProp<Inductor>("Inductance", tr("Inductance"), "H"
@@ -56,6 +58,31 @@ Inductor::Inductor( QString type, QString id )
 }
 Inductor::~Inductor(){}
 
+double Inductor::updtRes()
+{
+    switch( m_stepMethod ){
+        case reactEuler:       return m_inductance/m_tStep;
+        case reactTrapezoidal: return 2*m_inductance/m_tStep;
+        case reactGear2:{
+            double w = gearRatio();
+            return (1+2*w)/(1+w)*m_inductance/m_tStep;
+    }   }
+    return m_inductance/m_tStep;
+}
+
+double Inductor::updtCurr() // Companion current source from last step state
+{
+    switch( m_stepMethod ){
+        case reactEuler:       return -m_curr;
+        case reactTrapezoidal: return -m_curr - m_volt*m_admit;
+        case reactGear2:{
+            double w = gearRatio();
+            double a0 = (1+2*w)/(1+w);
+            return ( -(1+w)*m_curr + w*w/(1+w)*m_state[1] )/a0;
+    }   }
+    return -m_curr;
+}
+
 void Inductor::setCurrentValue( double c )
 {
     m_inductance = c;
@@ -19,7 +19,7 @@ class Inductor : public Reactive
  static Component* construct( QString type, QString id );
  static LibraryItem* libraryItem();
 
-        double indCurrent() { return m_curSource; }
+        double indCurrent() { return m_curr; }
 
         virtual void setCurrentValue( double c ) override;
 
@@ -28,8 +28,9 @@ class Inductor : public Reactive
         virtual void paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w ) override;
 
     protected:
-        virtual double updtRes()  override { return m_inductance/m_tStep; }
-        virtual double updtCurr() override { return m_curSource - m_volt*m_admit; }
+        virtual double updtRes()  override;
+        virtual double updtCurr() override;
+        virtual double stateVar() override { return m_curr; }
 
         double m_inductance;
 };
@@ -35,6 +35,7 @@ void Reactive::initialize()
 {
     m_crashed = false;
     m_warning = false;
+    m_stepper = nullptr;
 
     m_midEnode = new eNode( m_elmId+"-mideNode");
 }
@@ -3,6 +3,10 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+
 #include "chip.h"
 #include "circuitwidget.h"
 #include "mainwindow.h"
@@ -14,6 +18,43 @@
 
 QString Chip::s_subcType = "None";
 
+struct pkgCache_t // Packages read from a file
+{
+    QDateTime modified;
+    qint64    size;
+    bool      hasType;   // File sets s_subcType
+    QString   subcType;
+    QMap<QString, QString> packages;
+};
+static QHash<QString, pkgCache_t> s_pkgCache;
+static QString s_noType = "\n"; // Can't be a value read from file lines
+
+// Packages are parsed once per file (or when file is modified),
+// so placing many instances of a component doesn't read the same files again.
+static bool getCachedPkg( QFileInfo &fi, pkgCache_t** cache )
+{
+    auto it = s_pkgCache.find( fi.absoluteFilePath() );
+    if( it == s_pkgCache.end() ) return false;
+    if( it->modified != fi.lastModified() || it->size != fi.size() ) return false;
+
+    if( it->hasType ) Chip::s_subcType = it->subcType;
+    *cache = &(*it);
+    return true;
+}
+
+static void addCachedPkg( QFileInfo &fi, QString oldType, QMap<QString, QString> &packages )
+{
+    pkgCache_t cache;
+    cache.modified = fi.lastModified();
+    cache.size     = fi.size();
+    cache.hasType  = Chip::s_subcType != s_noType;
+    cache.subcType = Chip::s_subcType;
+    cache.packages = packages;
+    s_pkgCache[fi.absoluteFilePath()] = cache;
+
+    if( !cache.hasType ) Chip::s_subcType = oldType;
+}
+
 #define tr(str) simulideTr("Chip",str)
 
 Chip::Chip( QString type, QString id )
@@ -87,6 +128,13 @@ bool Chip::setPropStr( QString prop, QString val )
 
 QMap<QString, QString> Chip::getPackages( QString compFile ) // Static
 {
+    QFileInfo fi( compFile );
+    pkgCache_t* cache;
+    if( getCachedPkg( fi, &cache ) ) return cache->packages;
+
+    QString oldType = s_subcType;
+    s_subcType = s_noType;
+
     QMap<QString, QString> packageList;
 
     QString doc = fileToString( compFile, "Chip::getPackages");
@@ -125,9 +173,29 @@ QMap<QString, QString> Chip::getPackages( QString compFile ) // Static
         }
         if( addPackage && !pkgName.isEmpty() ) packageList[pkgName] = pkgStr;
     }
+    if( !doc.isEmpty() ) addCachedPkg( fi, oldType, packageList );
+    else if( s_subcType == s_noType ) s_subcType = oldType;
     return packageList;
 }
 
+QString Chip::loadPackage( QString pkgFile ) // Static, package file converted to new format
+{
+    QFileInfo fi( pkgFile );
+    pkgCache_t* cache;
+    if( getCachedPkg( fi, &cache ) ) return cache->packages.value("");
+
+    QString oldType = s_subcType;
+    s_subcType = s_noType;
+
+    QString pkgText = fileToString( pkgFile, "Chip::loadPackage" );
+    QMap<QString, QString> packages;
+    packages[""] = convertPackage( pkgText );
+
+    if( !pkgText.isEmpty() ) addCachedPkg( fi, oldType, packages );
+    else if( s_subcType == s_noType ) s_subcType = oldType;
+    return packages.value("");
+}
+
 QString Chip::convertPackage( QString pkgText ) // Static, converts xml to new format
 {
     QString pkgStr;
@@ -47,7 +47,8 @@ class Chip : public Component, public eElement
 
         virtual void paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w ) override;
 
- static QMap<QString, QString> getPackages( QString compText );
+ static QMap<QString, QString> getPackages( QString compFile );
+ static QString loadPackage( QString pkgFile );
  static QString convertPackage( QString pkgText );
  static QString cleanPinName( QString name );
  static QString s_subcType;
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QFileInfo>
+
 #include "subcircuit.h"
 #include "itemlibrary.h"
 #include "mainwindow.h"
@@ -27,6 +29,7 @@
 
 QString SubCircuit::m_subcDir = "";
 QStringList SubCircuit::s_graphProps;
+QHash<QString, subcTemplate_t*> SubCircuit::s_templates;
 
 Component* SubCircuit::construct( QString type, QString id )
 {
@@ -95,13 +98,11 @@ Component* SubCircuit::construct( QString type, QString id )
 
             Chip::s_subcType = "None";
             if( dip ){
-                QString pkgStr = fileToString( pkgeFile, "SubCircuit::construct" );
-                packageList[pkgName] = convertPackage( pkgStr );
+                packageList[pkgName] = loadPackage( pkgeFile );
                 subcTyp = s_subcType;
             }
             if( ls ){
-                QString pkgStr = fileToString( pkgFileLS, "SubCircuit::construct" );
-                packageList[pkgNameLS] = convertPackage( pkgStr );
+                packageList[pkgNameLS] = loadPackage( pkgFileLS );
                 if( subcTyp == "None" ) subcTyp = s_subcType;
             }
         }
@@ -177,17 +178,54 @@ SubCircuit::~SubCircuit(){}
 
 void SubCircuit::loadSubCircuitFile( QString file )
 {
-    QString doc = fileToString( file, "SubCircuit::loadSubCircuit" );
+    subcTemplate_t* subcTemp = getTemplate( file );
 
     QString oldFilePath = Circuit::self()->getFilePath();
     Circuit::self()->setFilePath( file );             // Path to find subcircuits/Scripted in our data folder
 
-    loadSubCircuit( doc );
+    loadSubCircuit( subcTemp );
 
     Circuit::self()->setFilePath( oldFilePath ); // Restore original filePath
 }
 
-void SubCircuit::loadSubCircuit( QString doc )
+// Subcircuit files are parsed once (or again if modified),
+// instances create their Components from the parsed items.
+subcTemplate_t* SubCircuit::getTemplate( QString file ) // Static
+{
+    QFileInfo fi( file );
+    QString path = fi.absoluteFilePath();
+
+    subcTemplate_t* subcTemp = s_templates.value( path );
+    if( subcTemp && subcTemp->modified == fi.lastModified()
+                 && subcTemp->size     == fi.size() ) return subcTemp;
+
+    if( !subcTemp ){ // Items reference doc: templates are never moved or deleted
+        subcTemp = new subcTemplate_t;
+        s_templates[path] = subcTemp;
+    }
+    subcTemp->modified = fi.lastModified();
+    subcTemp->size     = fi.size();
+    subcTemp->items.clear();
+    subcTemp->doc = fileToString( file, "SubCircuit::loadSubCircuit" );
+
+    QVector<QStringRef> docLines = subcTemp->doc.splitRef("\n");
+    for( QStringRef line : docLines )
+    {
+        if( !line.startsWith("<item") ) continue;
+
+        QVector<propStr_t> properties = parseXmlProps( line );
+        if( properties.isEmpty() ) continue;
+
+        propStr_t itemType = properties.first();
+        if( itemType.name != "itemtype") continue;
+        if( itemType.value == "Package" || itemType.value == "Subcircuit" ) continue;
+
+        subcTemp->items.append( properties );
+    }
+    return subcTemp;
+}
+
+void SubCircuit::loadSubCircuit( subcTemplate_t* subcTemp )
 {
     QString numId = m_id;
     numId = numId.split("-").last();
@@ -195,119 +233,112 @@ void SubCircuit::loadSubCircuit( QString doc )
 
     QList<Linker*> linkList;   // Linked  Component list
 
-    QVector<QStringRef> docLines = doc.splitRef("\n");
-    for( QStringRef line : docLines )
+    for( QVector<propStr_t> properties : subcTemp->items )
     {
-        if( line.startsWith("<item") )
+        propStr_t itemType = properties.takeFirst();
+        QString type = itemType.value.toString();
+
+        if( type == "Connector" )
         {
-            QVector<propStr_t> properties = parseXmlProps( line );
+            QString startPinId, endPinId, enodeId;
+            QStringList pointList;
 
-            propStr_t itemType = properties.takeFirst();
-            if( itemType.name != "itemtype") continue;
-            QString type = itemType.value.toString();
+            for( propStr_t prop : properties )
+            {
+                if     ( prop.name == "startpinid") startPinId = numId+"@"+prop.value.toString();
+                else if( prop.name == "endpinid"  ) endPinId   = numId+"@"+prop.value.toString();
+                else if( prop.name == "pointList" ) pointList  = prop.value.toString().split(",");
+            }
+            //startPinId = startPinId.replace("Pin-", "Pin_"); // Old TODELETE
+            //endPinId   =   endPinId.replace("Pin-", "Pin_"); // Old TODELETE
+
+            Pin* startPin = circ->m_LdPinMap.value( startPinId );
+            Pin* endPin   = circ->m_LdPinMap.value( endPinId );
 
-            if( type == "Package" || type == "Subcircuit" ) continue;
+            if( !startPin ) startPin = findPin( startPinId );
+            if( !endPin   ) endPin   = findPin( endPinId );
 
-            if( type == "Connector" )
+            if( startPin && endPin ) // Create Connection
             {
-                QString startPinId, endPinId, enodeId;
-                QStringList pointList;
+                startPin->setConPin( endPin );
+                endPin->setConPin( startPin );
+            }
+            else // Start or End pin not found
+            {
+                if( !startPin ) qDebug()<<"\n   ERROR!!  SubCircuit::loadSubCircuit: "<<m_name<<m_id+" null startPin in "<<type<<startPinId;
+                if( !endPin )   qDebug()<<"\n   ERROR!!  SubCircuit::loadSubCircuit: "<<m_name<<m_id+" null endPin in "  <<type<<endPinId;
+        }   }
+        else{
+            Component* comp = NULL;
 
-                for( propStr_t prop : properties )
-                {
-                    if     ( prop.name == "startpinid") startPinId = numId+"@"+prop.value.toString();
-                    else if( prop.name == "endpinid"  ) endPinId   = numId+"@"+prop.value.toString();
-                    else if( prop.name == "pointList" ) pointList  = prop.value.toString().split(",");
-                }
-                //startPinId = startPinId.replace("Pin-", "Pin_"); // Old TODELETE
-                //endPinId   =   endPinId.replace("Pin-", "Pin_"); // Old TODELETE
+            propStr_t circId = properties.takeFirst();
+            if( circId.name != "CircId") continue; /// ERROR
+            QString uid = circId.value.toString();
+            QString newUid = numId+"@"+uid;
 
-                Pin* startPin = circ->m_LdPinMap.value( startPinId );
-                Pin* endPin   = circ->m_LdPinMap.value( endPinId );
+            if( type == "Node" ) comp = new Node( type, newUid );
+            else                 comp = circ->createItem( type, newUid, false );
 
-                if( !startPin ) startPin = findPin( startPinId );
-                if( !endPin   ) endPin   = findPin( endPinId );
+            if( comp ){
+                comp->setIdLabel( uid ); // Avoid parent Uids in label
 
-                if( startPin && endPin ) // Create Connection
+                for( propStr_t prop : properties )
                 {
-                    startPin->setConPin( endPin );
-                    endPin->setConPin( startPin );
+                    QString propName = prop.name.toString();
+                    if( !s_graphProps.contains( propName ) ) comp->setPropStr( propName, prop.value.toString() );
                 }
-                else // Start or End pin not found
-                {
-                    if( !startPin ) qDebug()<<"\n   ERROR!!  SubCircuit::loadSubCircuit: "<<m_name<<m_id+" null startPin in "<<type<<startPinId;
-                    if( !endPin )   qDebug()<<"\n   ERROR!!  SubCircuit::loadSubCircuit: "<<m_name<<m_id+" null endPin in "  <<type<<endPinId;
-            }   }
-            else{
-                Component* comp = NULL;
-
-                propStr_t circId = properties.takeFirst();
-                if( circId.name != "CircId") continue; /// ERROR
-                QString uid = circId.value.toString();
-                QString newUid = numId+"@"+uid;
+                comp->setup();
+                comp->setParentItem( this );
 
-                if( type == "Node" ) comp = new Node( type, newUid );
-                else                 comp = circ->createItem( type, newUid, false );
+                if( m_subcType >= Board && comp->isGraphical() )
+                {
+                    QPointF pos = comp->boardPos();
 
-                if( comp ){
-                    comp->setIdLabel( uid ); // Avoid parent Uids in label
+                    comp->moveTo( pos );
+                    comp->setRotation( comp->boardRot() );
+                    comp->setHflip( comp->boardHflip() );
+                    comp->setVflip( comp->boardVflip() );
 
-                    for( propStr_t prop : properties )
+                    if( !this->collidesWithItem( comp ) ) // Don't show Components out of Board
                     {
-                        QString propName = prop.name.toString();
-                        if( !s_graphProps.contains( propName ) ) comp->setPropStr( propName, prop.value.toString() );
-                    }
-                    comp->setup();
-                    comp->setParentItem( this );
-
-                    if( m_subcType >= Board && comp->isGraphical() )
-                    {
-                        QPointF pos = comp->boardPos();
-
-                        comp->moveTo( pos );
-                        comp->setRotation( comp->boardRot() );
-                        comp->setHflip( comp->boardHflip() );
-                        comp->setVflip( comp->boardVflip() );
-
-                        if( !this->collidesWithItem( comp ) ) // Don't show Components out of Board
-                        {
-                            comp->setBoardPos( QPointF(-1e6,-1e6 ) ); // Used in setLogicSymbol to identify Components not visible
-                            comp->moveTo( QPointF( 0, 0 ) );
-                            comp->setVisible( false );
-                        }
-                        comp->setHidden( true, true, true ); // Boards: hide non graphical
-                        if( m_isLS && m_packageList.size() > 1 ) comp->setVisible( false ); // Don't show any component if Logic Symbol
-                    }
-                    else{
-                        comp->moveTo( QPointF(20, 20) );
-                        comp->setVisible( false );     // Not Boards: Don't show any component
+                        comp->setBoardPos( QPointF(-1e6,-1e6 ) ); // Used in setLogicSymbol to identify Components not visible
+                        comp->moveTo( QPointF( 0, 0 ) );
+                        comp->setVisible( false );
                     }
+                    comp->setHidden( true, true, true ); // Boards: hide non graphical
+                    if( m_isLS && m_packageList.size() > 1 ) comp->setVisible( false ); // Don't show any component if Logic Symbol
+                }
+                else{
+                    comp->moveTo( QPointF(20, 20) );
+                    comp->setVisible( false );     // Not Boards: Don't show any component
+                }
 
-                    if( comp->itemType() == "MCU" )
-                    {
-                        comp->remProperty("Logic_Symbol");
-                        Mcu* mcu = (Mcu*)comp;
-                        QString program = mcu->program();
-                        if( !program.isEmpty() ) mcu->load( m_subcDir+"/"+program );
-                    }
-                    if( comp->isMainComp() ) m_mainComponents[uid] = comp; // This component will add it's Context Menu and properties
+                if( comp->itemType() == "MCU" )
+                {
+                    comp->remProperty("Logic_Symbol");
+                    Mcu* mcu = (Mcu*)comp;
+                    QString program = mcu->program();
+                    if( !program.isEmpty() ) mcu->load( m_subcDir+"/"+program );
+                }
+                if( comp->isMainComp() ) m_mainComponents[uid] = comp; // This component will add it's Context Menu and properties
 
-                    m_compList.append( comp );
+                m_compList.append( comp );
+                m_compMap.insert( newUid, comp );
 
-                    if( comp->m_isLinker ){
-                        Linker* l = dynamic_cast<Linker*>(comp);
-                        if( l->hasLinks() ) linkList.append( l );
-                    }
+                if( comp->m_isLinker ){
+                    Linker* l = dynamic_cast<Linker*>(comp);
+                    if( l->hasLinks() ) linkList.append( l );
+                }
 
-                    if( type == "Tunnel" ) // Make Circuit Tunnel names unique for this subcircuit
-                    {
-                        Tunnel* tunnel = static_cast<Tunnel*>( comp );
-                        tunnel->setTunnelUid( tunnel->name() );
-                        tunnel->setName( m_id+"-"+tunnel->name() );
-                        m_subcTunnels.append( tunnel );
-                }   }
-                else qDebug() << "SubCircuit:"<<m_name<<m_id<< "ERROR Creating Component: "<<type<<uid;
-    }   }   }
+                if( type == "Tunnel" ) // Make Circuit Tunnel names unique for this subcircuit
+                {
+                    Tunnel* tunnel = static_cast<Tunnel*>( comp );
+                    tunnel->setTunnelUid( tunnel->name() );
+                    tunnel->setName( m_id+"-"+tunnel->name() );
+                    m_subcTunnels.append( tunnel );
+            }   }
+            else qDebug() << "SubCircuit:"<<m_name<<m_id<< "ERROR Creating Component: "<<type<<uid;
+    }   }
     for( Linker* l : linkList ) l->createLinks( &m_compList );
 }
 
@@ -400,7 +431,8 @@ Pin* SubCircuit::findPin( QString pinId )
     pinId = words.takeLast();
     QString compId = words.join("-");
 
-    for( Component* comp : m_compList ) if( comp->getUid() == compId ) return comp->getPin( pinId );
+    Component* comp = m_compMap.value( compId );
+    if( comp ) return comp->getPin( pinId );
 
     return nullptr;
 }
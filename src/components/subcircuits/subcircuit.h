@@ -6,11 +6,21 @@
 #ifndef SUBCIRCUIT_H
 #define SUBCIRCUIT_H
 
+#include <QDateTime>
+
 #include "chip.h"
 
 class Tunnel;
 class LibraryItem;
 
+struct subcTemplate_t  // Parsed subcircuit file, shared by all instances
+{
+    QDateTime modified;
+    qint64    size;
+    QString   doc;                        // File content, referenced by items
+    QList<QVector<propStr_t>> items;      // Components and Connectors properties
+};
+
 class SubCircuit : public Chip
 {
     public:
@@ -33,7 +43,10 @@ class SubCircuit : public Chip
 
     protected:
         void loadSubCircuitFile( QString file );
-        void loadSubCircuit( QString doc );
+        void loadSubCircuit( subcTemplate_t* subcTemp );
+
+ static subcTemplate_t* getTemplate( QString file );
+ static QHash<QString, subcTemplate_t*> s_templates;
 
         void addMainCompsMenu( QMenu* menu );
 
@@ -49,6 +62,7 @@ class SubCircuit : public Chip
         static QString m_subcDir;      // Subcircuit Path
 
         QList<Component*>       m_compList;
+        QHash<QString, Component*> m_compMap; // Component Id to Component* (for Pin search)
         QList<Tunnel*>          m_subcTunnels;
         QHash<QString, Tunnel*> m_pinTunnels;
 
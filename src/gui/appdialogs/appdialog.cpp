@@ -57,9 +57,18 @@ AppDialog::AppDialog( QWidget* parent )
     }
     reactStepBox->setValue( step );
     reactStepUnitBox->setCurrentIndex( unit );
+    reactMethodBox->setCurrentIndex( Simulator::self()->reactMethod() );
+    reactAdaptive->setChecked( Simulator::self()->reactAdaptive() );
+    reactSync->setChecked( Simulator::self()->reactSync() );
 
     nlStepsBox->setValue( Simulator::self()->maxNlSteps() );
     slopeStepsBox->setValue( Simulator::self()->slopeSteps() );
+    sparseSolver->setChecked( Simulator::self()->sparseSolver() );
+    lowRankUpdates->setChecked( Simulator::self()->lowRankUpdates() );
+    parallelSolver->setChecked( Simulator::self()->parallelSolver() );
+    logicNets->setChecked( Simulator::self()->logicNets() );
+    mcuQuantum->setChecked( Simulator::self()->mcuQuantum() );
+    unthrottled->setChecked( Simulator::self()->unthrottled() );
     m_blocked = false;
 
     updtSpeedPer();
@@ -246,6 +255,24 @@ void AppDialog::on_reactStepBox_editingFinished()
     updtReactStep();
 }
 
+void AppDialog::on_reactMethodBox_currentIndexChanged( int index )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setReactMethod( index );
+}
+
+void AppDialog::on_reactAdaptive_toggled( bool a )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setReactAdaptive( a );
+}
+
+void AppDialog::on_reactSync_toggled( bool s )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setReactSync( s );
+}
+
 void AppDialog::updtReactStep()
 {
     if( m_blocked ) return;
@@ -254,11 +281,47 @@ void AppDialog::updtReactStep()
     Simulator::self()->setReactStep( reactStep );
 }
 
+void AppDialog::on_unthrottled_toggled( bool u )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setUnthrottled( u );
+}
+
 void AppDialog::on_slopeStepsBox_editingFinished()
 {
     Simulator::self()->setSlopeSteps( slopeStepsBox->value() );
 }
 
+void AppDialog::on_sparseSolver_toggled( bool sparse )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setSparseSolver( sparse );
+}
+
+void AppDialog::on_lowRankUpdates_toggled( bool lowRank )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setLowRankUpdates( lowRank );
+}
+
+void AppDialog::on_parallelSolver_toggled( bool parallel )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setParallelSolver( parallel );
+}
+
+void AppDialog::on_logicNets_toggled( bool logic )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setLogicNets( logic );
+}
+
+void AppDialog::on_mcuQuantum_toggled( bool quantum )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setMcuQuantum( quantum );
+}
+
 void AppDialog::on_fontName_currentFontChanged( const QFont &f )
 {
     MainWindow::self()->setDefaultFontName( f.family() );
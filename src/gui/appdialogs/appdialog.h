@@ -52,9 +52,21 @@ class AppDialog : public QDialog, private Ui::AppDialog
 
         void on_reactStepUnitBox_currentIndexChanged( int index );
         void on_reactStepBox_editingFinished();
+        void on_reactMethodBox_currentIndexChanged( int index );
+        void on_reactAdaptive_toggled( bool a );
+        void on_reactSync_toggled( bool s );
+
+        void on_unthrottled_toggled( bool u );
 
         void on_slopeStepsBox_editingFinished();
 
+        void on_sparseSolver_toggled( bool sparse );
+        void on_lowRankUpdates_toggled( bool lowRank );
+        void on_parallelSolver_toggled( bool parallel );
+        void on_logicNets_toggled( bool logic );
+
+        void on_mcuQuantum_toggled( bool quantum );
+
     private slots:
         void on_fontName_currentFontChanged( const QFont &f );
 
@@ -90,10 +90,9 @@ Circuit::~Circuit()
     QFile::remove( m_backupPath ); // Remove backup file
 }
 
-Component* Circuit::getCompById( QString id )
+Component* Circuit::getCompById( QString id ) // m_compMap also holds Nodes and Connectors
 {
-    for( Component* comp : m_compList ) if( comp->getUid() == id ) return comp;
-    return nullptr;
+    return dynamic_cast<Component*>( m_compMap.value( id ) );
 }
 
 QString Circuit::getSeqNumber( QString name )
@@ -132,6 +131,9 @@ QString Circuit::replaceId( QString pinName )
 
 Pin* Circuit::findPin( QString id )
 {
+    Pin* pin = m_pinMap.value( id );
+    if( pin ) return pin;
+
     QStringList words = id.split("-");
     id = words.takeLast();
     QString compId = words.join("-");
@@ -401,7 +403,7 @@ void Circuit::loadStrDoc( QString &doc )
     else
     {
         for( Component* comp : compList ) comp->moveSignal();
-        m_compList = compList;
+        m_compList += compList; // Undo/Redo add to existing Components
     }
 
     m_nodeList += nodeList;
@@ -20,6 +20,7 @@
 #include "infowidget.h"
 #include "about.h"
 #include "utils.h"
+#include "batchtest.h"
 
 CircuitWidget* CircuitWidget::m_pSelf = 0l;
 
@@ -246,7 +247,7 @@ bool CircuitWidget::newCircuit()
     if( EditorWindow::self() && EditorWindow::self()->debugStarted() ) EditorWindow::self()->stop();
     else if( Simulator::self() ) powerCircOff();
     
-    if( MainWindow::self()->windowTitle().endsWith('*') )
+    if( MainWindow::self()->windowTitle().endsWith('*') && !BatchTest::isHeadless() )
     {
         const QMessageBox::StandardButton ret
         = QMessageBox::warning(this, "CircuitWidget::newCircuit",
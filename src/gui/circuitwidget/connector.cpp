@@ -42,7 +42,8 @@ new StrProp<Connector>( "pointList" ,"","", this, &Connector::pListStr,   &Conne
 }
 Connector::~Connector()
 {
-    Circuit::self()->compMap()->remove( m_id );
+    QHash<QString, CompBase*>* compMap = Circuit::self()->compMap();
+    if( compMap->value( m_id ) == this ) compMap->remove( m_id ); // Undo could create a new one with same id
 }
 
 void Connector::remNullLines()      // Remove lines with leght = 0 or aligned
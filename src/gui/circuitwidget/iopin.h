@@ -37,7 +37,7 @@ class IoPin : public Pin, public eElement
 
         virtual void scheduleState( bool state, uint64_t time );
 
-        //pinMode_t pinMode() { return m_pinMode; }
+        pinMode_t pinMode() { return m_pinMode; }
         void setPinMode( pinMode_t mode );
         void setPinMode( uint mode ) { setPinMode( (pinMode_t) mode ); }
 
@@ -78,6 +78,7 @@ class IoPin : public Pin, public eElement
         }
 
         void setStateZ( bool z );
+        bool stateZ() { return m_stateZ; }
         virtual void setPullup( bool up );
 
         virtual void setInverted( bool invert ) override;
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QDir>
+#include <QDebug>
+#include <math.h>
+#include <cstring>
+
+#include "datacapture.h"
+
+// Sample: [channel | type<<4] [time delta varint] [value: varint or 8 bytes double]
+#define VALUE_INT 0
+#define VALUE_DBL 1
+
+DataCapture::DataCapture()
+{
+    m_ring.resize( CAPTURE_RING );
+    m_head = 0;
+    m_tail = 0;
+    m_running = false;
+    m_flush = false;
+    m_flushHead = 0;
+    m_file = nullptr;
+}
+DataCapture::~DataCapture()
+{
+    close();
+}
+
+bool DataCapture::open()
+{
+    close();
+
+    m_file = new QTemporaryFile( QDir::tempPath()+"/simulide_XXXXXX.cap" );
+    if( !m_file->open() )
+    {
+        qDebug() << "DataCapture::open Error: Cannot create capture file" << m_file->fileName();
+        delete m_file;
+        m_file = nullptr;
+        return false;
+    }
+    m_head = 0;
+    m_tail = 0;
+    m_flush = false;
+    m_chunks.clear();
+    m_data.clear();
+    m_data.reserve( CAPTURE_CHUNK+32 );
+    m_count = 0;
+
+    m_running = true;
+    m_writer = std::thread( &DataCapture::writeLoop, this );
+    return true;
+}
+
+void DataCapture::stop()
+{
+    m_running = false;
+    if( m_writer.joinable() ) m_writer.join(); // Writer encodes remaining samples before ending
+}
+
+void DataCapture::close()
+{
+    stop();
+    if( !m_file ) return;
+
+    delete m_file; // Removes capture file
+    m_file = nullptr;
+    m_chunks.clear();
+}
+
+void DataCapture::flush()
+{
+    if( !m_running ) return;
+    m_flushHead = m_head.load( std::memory_order_acquire );
+    m_flush = true;
+    while( m_flush ) QThread::msleep( 1 );
+}
+
+int DataCapture::chunks()
+{
+    QMutexLocker locker( &m_chunkMutex );
+    return m_chunks.size();
+}
+
+bool DataCapture::readChunk( int i, std::vector<capSample_t>* samples )
+{
+    samples->clear();
+    if( !m_file ) return false;
+
+    m_chunkMutex.lock();
+    chunk_t chunk = m_chunks.at( i );
+    m_chunkMutex.unlock();
+
+    QFile file( m_file->fileName() ); // Own handle: writer thread keeps appending
+    if( !file.open( QIODevice::ReadOnly ) ) return false;
+    if( !file.seek( chunk.offset ) ) return false;
+    QByteArray data = file.read( chunk.size );
+    if( (uint32_t)data.size() != chunk.size ) return false;
+
+    const uint8_t* p   = (const uint8_t*)data.constData();
+    const uint8_t* end = p+data.size();
+
+    auto getVarint = [&](){
+        uint64_t v = 0;
+        for( int shift=0; p<end && shift<64; shift+=7 ){
+            uint8_t b = *p++;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if( !(b & 0x80) ) break;
+        }
+        return v;
+    };
+    samples->reserve( chunk.count );
+    uint64_t time = chunk.start;
+
+    for( uint32_t n=0; n<chunk.count && p<end; ++n )
+    {
+        uint8_t tag = *p++;
+        time += getVarint();
+        double value;
+        if( (tag>>4) == VALUE_DBL )
+        {
+            if( end-p < 8 ) return false;
+            memcpy( &value, p, 8 );
+            p += 8;
+        }
+        else value = getVarint();
+
+        samples->push_back( { time, value, (uint)(tag & 0x0F) } );
+    }
+    return true;
+}
+
+void DataCapture::writeLoop() // Runs in writer thread
+{
+    while( true )
+    {
+        uint32_t tail = m_tail.load( std::memory_order_relaxed );
+        uint32_t head = m_head.load( std::memory_order_acquire );
+
+        for( ; tail!=head; ++tail )
+        {
+            encode( m_ring[tail & (CAPTURE_RING-1)] );
+            if( m_data.size() >= CAPTURE_CHUNK ) writeChunk();
+        }
+        m_tail.store( tail, std::memory_order_release );
+
+        if( !m_running )   // Closing: samples added before are already encoded
+        {
+            writeChunk();
+            m_flush = false;
+            break;
+        }
+        if( m_flush && (int32_t)(tail-m_flushHead) >= 0 ) // Samples added before flush request are encoded
+        {
+            writeChunk();
+            m_flush = false;
+        }
+        else if( head == m_head.load( std::memory_order_acquire ) ) QThread::msleep( 1 ); // Nothing to do
+    }
+}
+
+void DataCapture::writeChunk()
+{
+    if( m_count == 0 ) return;
+
+    chunk_t chunk = { m_file->pos(), m_chunkStart, m_count, (uint32_t)m_data.size() };
+
+    if( m_file->write( m_data ) != m_data.size() )
+        qDebug() << "DataCapture::writeChunk Error writing file" << m_file->fileName();
+    m_file->flush();
+
+    m_chunkMutex.lock();
+    m_chunks.push_back( chunk );
+    m_chunkMutex.unlock();
+
+    m_data.resize( 0 );
+    m_count = 0;
+}
+
+void DataCapture::encode( const capSample_t& s )
+{
+    if( m_count == 0 ) m_lastTime = m_chunkStart = s.time; // Chunks can be decoded alone
+    m_count++;
+
+    bool isInt = s.value >= 0 && s.value < 4.5e15 && floor( s.value ) == s.value;
+
+    m_data.append( (char)( (s.channel & 0x0F) | ((isInt ? VALUE_INT : VALUE_DBL)<<4) ) );
+    putVarint( s.time-m_lastTime );
+    m_lastTime = s.time;
+
+    if( isInt ) putVarint( (uint64_t)s.value );
+    else        m_data.append( (const char*)&s.value, 8 );
+}
+
+void DataCapture::putVarint( uint64_t v )
+{
+    while( v >= 0x80 )
+    {
+        m_data.append( (char)( (v & 0x7F) | 0x80 ) );
+        v >>= 7;
+    }
+    m_data.append( (char)v );
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef DATACAPTURE_H
+#define DATACAPTURE_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <inttypes.h>
+
+#include <QMutex>
+#include <QThread>
+#include <QTemporaryFile>
+
+#define CAPTURE_RING  (1<<16)  // Samples in Simulation to Writer ring (power of 2)
+#define CAPTURE_CHUNK (1<<16)  // Bytes of encoded samples per File chunk
+
+struct capSample_t{
+    uint64_t time;
+    double   value;
+    uint     channel;
+};
+
+// Streams samples to a temporary file without depth limit.
+// Samples are added from Simulation thread into a lock-free ring,
+// a writer thread encodes them in chunks: time deltas and integer values as varints.
+// The writer has its own thread, not the global QThreadPool used by Simulator.
+class DataCapture
+{
+    public:
+        DataCapture();
+        ~DataCapture();
+
+        bool open();   // Create new capture file and start writer thread
+        void stop();   // Write pending samples and end writer thread, keep capture file
+        void close();  // Stop writer thread and remove capture file
+
+        bool isOpen() { return m_file != nullptr; } // Capture file available (also after stop)
+
+        void addSample( uint64_t time, uint channel, double value ) // Only from Simulation thread
+        {
+            if( !m_running ) return;
+            uint32_t head = m_head.load( std::memory_order_relaxed );
+            while( head-m_tail.load( std::memory_order_acquire ) >= CAPTURE_RING ) // Ring full: wait for writer
+            {
+                if( !m_running ) return;
+                QThread::yieldCurrentThread();
+            }
+
+            m_ring[head & (CAPTURE_RING-1)] = { time, value, channel };
+            m_head.store( head+1, std::memory_order_release );
+        }
+
+        void flush(); // Wait until all samples added so far are in file
+
+        int  chunks();
+        bool readChunk( int i, std::vector<capSample_t>* samples ); // Samples in time order
+
+    private:
+        struct chunk_t{
+            qint64   offset;
+            uint64_t start;   // Time of first sample
+            uint32_t count;
+            uint32_t size;
+        };
+
+        void writeLoop();
+        void writeChunk();
+        void encode( const capSample_t& s );
+        void putVarint( uint64_t v );
+
+        std::vector<capSample_t> m_ring;
+        std::atomic<uint32_t> m_head;  // Written by Simulation thread
+        std::atomic<uint32_t> m_tail;  // Written by writer thread
+        std::atomic<bool> m_running;
+        std::atomic<bool> m_flush;
+        std::atomic<uint32_t> m_flushHead;
+
+        QByteArray m_data;             // Chunk being encoded
+        uint64_t m_chunkStart;
+        uint64_t m_lastTime;
+        uint32_t m_count;
+
+        std::vector<chunk_t> m_chunks; // Chunks already in file
+        QMutex m_chunkMutex;
+
+        QTemporaryFile* m_file;
+        std::thread m_writer;
+};
+
+#endif
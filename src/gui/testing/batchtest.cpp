@@ -4,14 +4,24 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QTimer>
+#include <QFileInfo>
+#include <QProcess>
+#include <QEventLoop>
+#include <QCoreApplication>
+#include <QTextStream>
 #include <QDebug>
+#include <string.h>
 
 #include "batchtest.h"
 #include "component.h"
 #include "circuitwidget.h"
+#include "simulator.h"
+#include "e-node.h"
 
 bool BatchTest::m_running = false;
+bool BatchTest::m_headless = false;
 QString BatchTest::m_currentFile;
+QString BatchTest::m_dumpFile;
 QStringList BatchTest::m_failedTests;
 QStringList BatchTest::m_circFiles;
 QList<Component*> BatchTest::m_testUnits;
@@ -33,6 +43,133 @@ void BatchTest::doBatchTest( QString folder )
     runNextCircuit();
 }
 
+int BatchTest::runHeadless( QString path, uint64_t endTime, int jobs, QString dumpFile ) // Run circuits without GUI updates or Timer
+{
+    m_failedTests.clear();
+    m_circFiles.clear();
+    m_dumpFile = dumpFile;
+
+    QFileInfo info( path );
+    if     ( info.isDir() )                            prepareTest( QDir( path ) );
+    else if( info.exists() && path.endsWith(".sim1") ) m_circFiles.append( info.absoluteFilePath() );
+
+    if( m_circFiles.isEmpty() )
+    {
+        qDebug() << "No circuits found:" << path;
+        return 2;
+    }
+    if( !m_dumpFile.isEmpty() ) // One section per circuit is appended
+    {
+        QFile file( m_dumpFile );
+        if( !file.open( QIODevice::WriteOnly | QIODevice::Text ) )
+        {
+            qDebug() << "Can't write" << m_dumpFile;
+            return 2;
+        }
+    }
+    m_headless = true;
+    Simulator::self()->setHeadless( true );
+
+    if( jobs > 1 && m_circFiles.size() > 1 ) runWorkers( endTime, jobs ); // One process per circuit
+    else                                     runCircuits( endTime );      // All in this process
+
+    m_running = false;
+    m_circFiles.clear();
+    printResults();
+
+    return m_failedTests.isEmpty() ? 0 : 1;
+}
+
+void BatchTest::runCircuits( uint64_t endTime )
+{
+    for( QString file : m_circFiles )
+    {
+        m_currentFile = file;
+        qDebug() << "Testing" << m_currentFile;
+        CircuitWidget::self()->loadCirc( m_currentFile );
+
+        m_testUnits.clear();
+        m_running = true;
+        CircuitWidget::self()->powerCircOn();
+        Simulator::self()->runHeadless( endTime ); // Until endTime or all test units finished
+
+        if( !m_testUnits.isEmpty() ) // Some test units didn't finish
+        {
+            qDebug() << "Test time limit reached:" << m_currentFile;
+            if( !m_failedTests.contains( m_currentFile ) ) m_failedTests.append( m_currentFile );
+        }
+        if( !m_dumpFile.isEmpty() ) dumpVoltages();
+        CircuitWidget::self()->powerCircOff();
+    }
+}
+
+void BatchTest::runWorkers( uint64_t endTime, int jobs )
+{
+    // Simulator, Circuit, etc. are singletons: run each circuit in a worker process
+    QString program = QCoreApplication::applicationFilePath();
+    QString timeArg = QString::number( endTime/1e12, 'g', 17 );
+
+    QStringList pending = m_circFiles;
+    QList<QProcess*> workers;
+    QEventLoop loop;
+    int n = 0;
+
+    while( !pending.isEmpty() || !workers.isEmpty() )
+    {
+        while( !pending.isEmpty() && workers.size() < jobs )
+        {
+            QString file = pending.takeFirst();
+            QProcess* worker = new QProcess();
+            worker->setProcessChannelMode( QProcess::MergedChannels );
+            worker->setProperty( "circFile", file );
+            QObject::connect( worker, QOverload<int, QProcess::ExitStatus>::of( &QProcess::finished )
+                            , &loop, &QEventLoop::quit );
+            QObject::connect( worker, &QProcess::errorOccurred, &loop, &QEventLoop::quit );
+
+            QStringList args = {"--headless", file, timeArg, "--jobs=1"};
+            if( !m_dumpFile.isEmpty() ) args.append("--dump="+m_dumpFile+"."+QString::number( n ) );
+            n++;
+
+            worker->start( program, args );
+            workers.append( worker );
+        }
+        bool finished = false;
+        for( QProcess* worker : workers )
+            if( worker->state() == QProcess::NotRunning ) finished = true;
+
+        if( !finished ) loop.exec(); // Until some worker finishes
+
+        for( QProcess* worker : QList<QProcess*>( workers ) )
+        {
+            if( worker->state() != QProcess::NotRunning ) continue;
+            workers.removeOne( worker );
+
+            QString file = worker->property("circFile").toString();
+            bool ok = (worker->exitStatus() == QProcess::NormalExit)
+                   && (worker->error() == QProcess::UnknownError)
+                   && (worker->exitCode() == 0);
+
+            if( ok ) qDebug() << "Passed" << file;
+            else{
+                m_failedTests.append( file );
+                qDebug() << "Failed" << file << endl << worker->readAll().constData();
+            }
+            worker->deleteLater();
+        }
+    }
+    if( m_dumpFile.isEmpty() ) return;
+
+    QFile dump( m_dumpFile );  // Join worker dumps in circuit order
+    if( !dump.open( QIODevice::Append ) ) return;
+    for( int i=0; i<n; ++i )
+    {
+        QFile part( m_dumpFile+"."+QString::number( i ) );
+        if( !part.open( QIODevice::ReadOnly ) ) continue; // Worker failed before dumping
+        dump.write( part.readAll() );
+        part.remove();
+    }
+}
+
 void BatchTest::prepareTest( QDir baseDir )
 {
     QStringList circList = baseDir.entryList( {"*.sim1"}, QDir::Files );
@@ -58,12 +195,7 @@ void BatchTest::runNextCircuit()
     if( m_circFiles.isEmpty() )  // All tests completed
     {
         m_running = false;
-
-        if( m_failedTests.isEmpty() ) qDebug() << "All tests passed";
-        else {
-            qDebug() << m_failedTests.size() << "Tests failed:";
-            for( QString file : m_failedTests ) qDebug() << file;
-        }
+        printResults();
         return;
     }
     m_currentFile = m_circFiles.takeFirst();
@@ -76,6 +208,34 @@ void BatchTest::runNextCircuit()
     checkFinished();
 }
 
+void BatchTest::printResults()
+{
+    if( m_failedTests.isEmpty() ) qDebug() << "All tests passed";
+    else {
+        qDebug() << m_failedTests.size() << "Tests failed:";
+        for( QString file : m_failedTests ) qDebug() << file;
+    }
+}
+
+void BatchTest::dumpVoltages() // Node voltages as raw double bits: compare runs exactly
+{
+    QFile file( m_dumpFile );
+    if( !file.open( QIODevice::Append | QIODevice::Text ) )
+    {
+        qDebug() << "Can't write" << m_dumpFile;
+        return;
+    }
+    QTextStream out( &file );
+    out << "# " << m_currentFile << "\n";
+    for( eNode* node : Simulator::self()->eNodeList() )
+    {
+        double volt = node->getVolt();
+        quint64 bits;
+        memcpy( &bits, &volt, sizeof( bits ) );
+        out << node->itemId() << " " << QString::number( bits, 16 ) << "\n";
+    }
+}
+
 void BatchTest::checkFinished()
 {
     if( m_running ) QTimer::singleShot( 100, BatchTest::checkFinished );
@@ -94,6 +254,10 @@ void BatchTest::testCompleted( Component* c, bool ok ) // A test unit completed
     if( !ok ){  // Test failed
         if( !m_failedTests.contains( m_currentFile) ) m_failedTests.append( m_currentFile );
     }
-    if( m_testUnits.isEmpty() ) m_running = false; // All test units in this Circuit finished
+    if( m_testUnits.isEmpty() ) // All test units in this Circuit finished
+    {
+        m_running = false;
+        if( m_headless ) Simulator::self()->pauseSim(); // Break runHeadless() loop
+    }
 }
 
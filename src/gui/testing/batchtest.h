@@ -15,8 +15,10 @@ class BatchTest
     public:
 
         static void doBatchTest( QString folder );
+        static int  runHeadless( QString path, uint64_t endTime, int jobs=1, QString dumpFile="" ); // Returns exit status
 
         static bool isRunning() { return m_running; }
+        static bool isHeadless() { return m_headless; }
         static void addTestUnit( Component* c );
         static void testCompleted( Component* c, bool ok );
 
@@ -25,10 +27,16 @@ class BatchTest
     private:
         static void prepareTest( QDir dir );
         static void runNextCircuit();
+        static void runCircuits( uint64_t endTime );
+        static void runWorkers( uint64_t endTime, int jobs );
+        static void printResults();
+        static void dumpVoltages();
 
         static bool m_running;
+        static bool m_headless;
 
         static QString m_currentFile;
+        static QString m_dumpFile;
 
         static QStringList m_failedTests;
         static QStringList m_circFiles;
@@ -6,6 +6,7 @@
 #include <QApplication>
 #include <QTranslator>
 #include <QStandardPaths>
+#include <QThread>
 #include <QtGui>
 
 #include "mainwindow.h"
@@ -47,10 +48,45 @@ QString langFile( QString locale )
     return langF;
 }
 
+int runHeadless( int argc, char *argv[] ) // simulide --headless <circuit.sim1|folder> [time_s] [--jobs=N] [--dump=file]
+{
+    if( argc < 3 )
+    {
+        fprintf( stderr, "Usage: simulide --headless <circuit.sim1|folder> [time_s] [--jobs=N] [--dump=file]\n" );
+        return 2;
+    }
+    QString path = QString::fromLocal8Bit( argv[2] );
+
+    double time = 1;                      // Default: stop at 1 second of simulated time
+    int    jobs = QThread::idealThreadCount(); // Default: one worker process per core
+    QString dumpFile;                     // Node voltages at end of simulation
+
+    for( int i=3; i<argc; ++i )
+    {
+        QString arg = QString::fromLocal8Bit( argv[i] );
+        bool ok = true;
+        if     ( arg.startsWith("--jobs=") ) jobs = arg.mid( 7 ).toInt( &ok );
+        else if( arg.startsWith("--dump=") ) dumpFile = arg.mid( 7 );
+        else                                 time = arg.toDouble( &ok );
+
+        if( !ok || time <= 0 || jobs < 1 )
+        {
+            fprintf( stderr, "Invalid argument: %s\n", argv[i] );
+            return 2;
+        }
+    }
+
+    return BatchTest::runHeadless( path, time*1e12, jobs, dumpFile ); // Time in ps
+}
+
 int main( int argc, char *argv[] )
 {
     qInstallMessageHandler( myMessageOutput );
 
+    bool headless = (argc > 1) && (QString::fromLocal8Bit( argv[1] ) == "--headless");
+    if( headless && qgetenv("QT_QPA_PLATFORM").isEmpty() )
+        qputenv("QT_QPA_PLATFORM", "offscreen"); // No display needed
+
     QApplication app( argc, argv );
 
     QSettings settings( QStandardPaths::standardLocations( QStandardPaths::DataLocation).first()+"/simulide.ini",  QSettings::IniFormat, 0l );
@@ -73,6 +109,9 @@ int main( int argc, char *argv[] )
 
     MainWindow window;
     window.setLoc( locale );
+
+    if( headless ) return runHeadless( argc, argv ); // Run circuits and exit with status
+
     window.show();
 
     if( argc > 1 )
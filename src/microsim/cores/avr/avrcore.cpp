@@ -27,6 +27,8 @@ AvrCore::AvrCore( eMcu* mcu )
     else RAMPZ = NULL;
 
     m_retCycles = 4; // In AVR only used for Jump to ISR
+
+    m_decoded.resize( m_progSize, avrInst( OP_NONE ) );
 }
 AvrCore::~AvrCore() {}
 
@@ -147,657 +149,673 @@ inline int AvrCore::is_instr_32b( uint32_t pc )
             o == 0x940f;   // CALL Long Call to sub
 }
 
+void AvrCore::flashChanged( uint32_t addr )
+{
+    if( addr < m_decoded.size() ) m_decoded[addr].op = OP_NONE; // Decode again at next execution
+}
+
+inline avrInst_t AvrCore::avrInst( uint8_t op, uint8_t d, uint8_t r, int16_t k )
+{
+    avrInst_t inst;
+    inst.op = op;
+    inst.d  = d;
+    inst.r  = r;
+    inst.k  = k;
+    return inst;
+}
+
+avrInst_t AvrCore::decode( uint16_t instruction ) // Get instruction and operands
+{
+    const uint8_t d = (instruction >> 4) & 0x1f;
+    const uint8_t r = ((instruction >> 5) & 0x10) | (instruction & 0xf);
+
+    switch( instruction & 0xf000 )
+    {
+        case 0x0000:{
+            if( instruction == 0x0000 ) return avrInst( OP_NOP );                    // NOP
+            switch( instruction & 0xfc00 ){
+                case 0x0400: return avrInst( OP_CPC, d, r );                          // CPC -- 0000 01rd dddd rrrr
+                case 0x0c00: return avrInst( OP_ADD, d, r );                          // ADD -- 0000 11rd dddd rrrr
+                case 0x0800: return avrInst( OP_SBC, d, r );                          // SBC -- 0000 10rd dddd rrrr
+            }
+            switch( instruction & 0xff00 ){
+                case 0x0100: return avrInst( OP_MOVW, ((instruction >> 4) & 0xf) << 1, (instruction & 0xf) << 1 ); // MOVW -- 0000 0001 dddd rrrr
+                case 0x0200: return avrInst( OP_MULS, 16 + ((instruction >> 4) & 0xf), 16 + (instruction & 0xf) ); // MULS -- 0000 0010 dddd rrrr
+                case 0x0300:{                                                        // MUL -- 0000 0011 fddd frrr
+                    uint8_t d3 = 16 + ((instruction >> 4) & 0x7);
+                    uint8_t r3 = 16 + (instruction & 0x7);
+                    switch( instruction & 0x88 ){
+                        case 0x00: return avrInst( OP_MULSU,  d3, r3 );               // MULSU  -- 0000 0011 0ddd 0rrr
+                        case 0x08: return avrInst( OP_FMUL,   d3, r3 );               // FMUL   -- 0000 0011 0ddd 1rrr
+                        case 0x80: return avrInst( OP_FMULS,  d3, r3 );               // FMULS  -- 0000 0011 1ddd 0rrr
+                        case 0x88: return avrInst( OP_FMULSU, d3, r3 );               // FMULSU -- 0000 0011 1ddd 1rrr
+            }   }   }
+        }break;
+        case 0x1000:{
+            switch( instruction & 0xfc00 ){
+                case 0x1800: return avrInst( OP_SUB,  d, r );                         // SUB  -- 0001 10rd dddd rrrr
+                case 0x1000: return avrInst( OP_CPSE, d, r );                         // CPSE -- 0001 00rd dddd rrrr
+                case 0x1400: return avrInst( OP_CP,   d, r );                         // CP   -- 0001 01rd dddd rrrr
+                case 0x1c00: return avrInst( OP_ADC,  d, r );                         // ADC  -- 0001 11rd dddd rrrr
+        }   }break;
+        case 0x2000:{
+            switch( instruction & 0xfc00 ){
+                case 0x2000: return avrInst( OP_AND, d, r );                          // AND -- 0010 00rd dddd rrrr
+                case 0x2400: return avrInst( OP_EOR, d, r );                          // EOR -- 0010 01rd dddd rrrr
+                case 0x2800: return avrInst( OP_OR,  d, r );                          // OR  -- 0010 10rd dddd rrrr
+                case 0x2c00: return avrInst( OP_MOV, d, r );                          // MOV -- 0010 11rd dddd rrrr
+        }   }break;
+        case 0x3000:                                                                 // CPI  -- 0011 kkkk hhhh kkkk
+        case 0x4000:                                                                 // SBCI -- 0100 kkkk hhhh kkkk
+        case 0x5000:                                                                 // SUBI -- 0101 kkkk hhhh kkkk
+        case 0x6000:                                                                 // ORI  -- 0110 kkkk hhhh kkkk
+        case 0x7000:                                                                 // ANDI -- 0111 kkkk hhhh kkkk
+        case 0xe000:{                                                                // LDI  -- 1110 kkkk hhhh kkkk
+            uint8_t h = 16 + ((instruction >> 4) & 0xf);
+            uint8_t k = ((instruction & 0x0f00) >> 4) | (instruction & 0xf);
+            switch( instruction & 0xf000 ){
+                case 0x3000: return avrInst( OP_CPI,  h, 0, k );
+                case 0x4000: return avrInst( OP_SBCI, h, 0, k );
+                case 0x5000: return avrInst( OP_SUBI, h, 0, k );
+                case 0x6000: return avrInst( OP_ORI,  h, 0, k );
+                case 0x7000: return avrInst( OP_ANDI, h, 0, k );
+                case 0xe000: return avrInst( OP_LDI,  h, 0, k );
+        }   }break;
+        case 0xa000:
+        case 0x8000:{                                                                // LDD/STD -- 10q0 qqsd dddd yqqq
+            uint8_t q = ((instruction & 0x2000) >> 8) | ((instruction & 0x0c00) >> 7) | (instruction & 0x7);
+            bool   st = instruction & 0x0200;
+            if( instruction & 0x0008 ) return avrInst( st ? OP_STD_Y : OP_LDD_Y, d, 0, q );
+            else                       return avrInst( st ? OP_STD_Z : OP_LDD_Z, d, 0, q );
+        }
+        case 0x9000:{
+            if( (instruction & 0xff0f) == 0x9408 )                                   // BSET/BCLR -- 1001 0100 Bsss 1000
+            {
+                uint8_t bit = (instruction >> 4) & 7;
+                return avrInst( (instruction & 0x0080) ? OP_BCLR : OP_BSET, bit );
+            }
+            switch( instruction ){
+                case 0x9588: return avrInst( OP_SLEEP );                              // SLEEP  -- 1001 0101 1000 1000
+                case 0x9598: return avrInst( OP_BREAK );                              // BREAK  -- 1001 0101 1001 1000
+                case 0x95a8: return avrInst( OP_WDR );                                // WDR    -- 1001 0101 1010 1000
+                case 0x95e8: return avrInst( OP_SPM );                                // SPM    -- 1001 0101 1110 1000
+                case 0x9409:                                                         // IJMP   -- 1001 0100 0000 1001
+                case 0x9419:                                                         // EIJMP  -- 1001 0100 0001 1001
+                case 0x9509:                                                         // ICALL  -- 1001 0101 0000 1001
+                case 0x9519:                                                         // EICALL -- 1001 0101 0001 1001
+                    return avrInst( OP_IJMP, (instruction & 0x10) != 0, (instruction & 0x100) != 0 ); // Extended, Call
+                case 0x9518: return avrInst( OP_RETI );                               // RETI   -- 1001 0101 0001 1000
+                case 0x9508: return avrInst( OP_RET );                                // RET    -- 1001 0101 0000 1000
+                case 0x95c8: return avrInst( OP_LPM, 0 );                             // LPM    -- 1001 0101 1100 1000
+                case 0x95d8: return avrInst( OP_ELPM, 0 );                            // ELPM   -- 1001 0101 1101 1000
+            }
+            switch( instruction & 0xfe0f ){
+                case 0x9000: return avrInst( OP_LDS, d );                             // LDS  -- 1001 000d dddd 0000
+                case 0x9005:
+                case 0x9004: return avrInst( OP_LPM,  d, instruction & 1 );           // LPM  -- 1001 000d dddd 01oo
+                case 0x9006:
+                case 0x9007: return avrInst( OP_ELPM, d, instruction & 1 );           // ELPM -- 1001 000d dddd 01oo
+                case 0x900c:
+                case 0x900d:
+                case 0x900e: return avrInst( OP_LD_X, d, instruction & 3 );           // LD X -- 1001 000d dddd 11oo
+                case 0x920c:
+                case 0x920d:
+                case 0x920e: return avrInst( OP_ST_X, d, instruction & 3 );           // ST X -- 1001 001d dddd 11oo
+                case 0x9009:
+                case 0x900a: return avrInst( OP_LD_Y, d, instruction & 3 );           // LD Y -- 1001 000d dddd 10oo
+                case 0x9209:
+                case 0x920a: return avrInst( OP_ST_Y, d, instruction & 3 );           // ST Y -- 1001 001d dddd 10oo
+                case 0x9200: return avrInst( OP_STS, d );                             // STS  -- 1001 001d dddd 0000
+                case 0x9001:
+                case 0x9002: return avrInst( OP_LD_Z, d, instruction & 3 );           // LD Z -- 1001 000d dddd 00oo
+                case 0x9201:
+                case 0x9202: return avrInst( OP_ST_Z, d, instruction & 3 );           // ST Z -- 1001 001d dddd 00oo
+                case 0x900f: return avrInst( OP_POP,  d );                            // POP  -- 1001 000d dddd 1111
+                case 0x920f: return avrInst( OP_PUSH, d );                            // PUSH -- 1001 001d dddd 1111
+                case 0x9400: return avrInst( OP_COM,  d );                            // COM  -- 1001 010d dddd 0000
+                case 0x9401: return avrInst( OP_NEG,  d );                            // NEG  -- 1001 010d dddd 0001
+                case 0x9402: return avrInst( OP_SWAP, d );                            // SWAP -- 1001 010d dddd 0010
+                case 0x9403: return avrInst( OP_INC,  d );                            // INC  -- 1001 010d dddd 0011
+                case 0x9405: return avrInst( OP_ASR,  d );                            // ASR  -- 1001 010d dddd 0101
+                case 0x9406: return avrInst( OP_LSR,  d );                            // LSR  -- 1001 010d dddd 0110
+                case 0x9407: return avrInst( OP_ROR,  d );                            // ROR  -- 1001 010d dddd 0111
+                case 0x940a: return avrInst( OP_DEC,  d );                            // DEC  -- 1001 010d dddd 1010
+                case 0x940c:
+                case 0x940d:                                                         // JMP  -- 1001 010a aaaa 110a
+                case 0x940e:
+                case 0x940f:{                                                        // CALL -- 1001 010a aaaa 111a
+                    uint8_t a = ((instruction & 0x01f0) >> 3) | (instruction & 1);   // Address high bits
+                    return avrInst( (instruction & 2) ? OP_CALL : OP_JMP, 0, 0, a );
+            }   }
+            switch( instruction & 0xff00 ){
+                case 0x9600:                                                         // ADIW -- 1001 0110 KKpp KKKK
+                case 0x9700:{                                                        // SBIW -- 1001 0111 KKpp KKKK
+                    uint8_t p = 24 + ((instruction >> 3) & 0x6);
+                    uint8_t k = ((instruction & 0x00c0) >> 2) | (instruction & 0xf);
+                    return avrInst( (instruction & 0x0100) ? OP_SBIW : OP_ADIW, p, 0, k );
+                }
+                case 0x9800:                                                         // CBI  -- 1001 1000 AAAA Abbb
+                case 0x9900:                                                         // SBIC -- 1001 1001 AAAA Abbb
+                case 0x9a00:                                                         // SBI  -- 1001 1010 AAAA Abbb
+                case 0x9b00:{                                                        // SBIS -- 1001 1011 AAAA Abbb
+                    uint8_t io   = ((instruction >> 3) & 0x1f) + 32;
+                    uint8_t mask = 1 << (instruction & 0x7);
+                    uint8_t op = OP_CBI + ((instruction >> 8) & 3); // CBI, SBIC, SBI, SBIS
+                    return avrInst( op, io, mask );
+            }   }
+            if( (instruction & 0xfc00) == 0x9c00 ) return avrInst( OP_MUL, d, r ); // MUL -- 1001 11rd dddd rrrr
+        }break;
+        case 0xb000:{                                                                // OUT/IN -- 1011 sAAd dddd AAAA
+            uint8_t A = ((((instruction >> 9) & 3) << 4) | (instruction & 0xf)) + 32;
+            return avrInst( (instruction & 0x0800) ? OP_OUT : OP_IN, d, A );
+        }
+        case 0xc000:                                                                 // RJMP  -- 1100 kkkk kkkk kkkk
+        case 0xd000:{                                                                // RCALL -- 1101 kkkk kkkk kkkk
+            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
+            return avrInst( (instruction & 0x1000) ? OP_RCALL : OP_RJMP, 0, 0, k );
+        }
+        case 0xf000:{
+            switch( instruction & 0xfe00 ){
+                case 0xf000:
+                case 0xf200:
+                case 0xf400:
+                case 0xf600:{                                                        // BRXC/BRXS -- 1111 0Boo oooo osss
+                    int16_t o = ((int16_t)(instruction << 6)) >> 9;                  // offset
+                    bool set = (instruction & 0x0400) == 0;                          // this bit means BRXC otherwise BRXS
+                    return avrInst( OP_BRANCH, instruction & 7, set, o );
+                }
+                case 0xf800:
+                case 0xf900: return avrInst( OP_BLD, d, 1 << (instruction & 7) );    // BLD  -- 1111 100d dddd 0bbb
+                case 0xfa00:
+                case 0xfb00: return avrInst( OP_BST, d, instruction & 7 );           // BST  -- 1111 101d dddd 0bbb
+                case 0xfc00:
+                case 0xfe00:                                                         // SBRS/SBRC -- 1111 11sd dddd 0bbb
+                    return avrInst( OP_SBRX, d, 1 << (instruction & 7), (instruction & 0x0200) != 0 );
+        }   }break;
+    }
+    return avrInst( OP_INVALID );
+}
+
 void AvrCore::runStep()
 {
     m_mcu->cyclesDone = 0;
-    uint16_t instruction = m_progMem[m_PC];
+
+    int cycles = execute( fetch() );
+
+    if( Simulator::self()->mcuQuantum() && !m_mcu->isDebugging() )
+    {
+        // Straight-line register only instructions run in this same step:
+        // they don't access I/O registers, RAM or change program flow.
+        // Stop if first instruction changed Mcu state (SLEEP).
+        while( cycles < AVR_BLOCK_CYCLES && m_mcu->state() == mcuRunning )
+        {
+            avrInst_t inst = fetch();
+            if( !isRegOp( inst.op ) ) break;
+            cycles += execute( inst );
+        }
+    }
+    m_mcu->cyclesDone = cycles;
+}
+
+avrInst_t AvrCore::fetch()
+{
+    avrInst_t inst = m_decoded[m_PC];
+    if( inst.op == OP_NONE ) inst = m_decoded[m_PC] = decode( m_progMem[m_PC] );
+    return inst;
+}
+
+bool AvrCore::isRegOp( uint8_t op )
+{
+    switch( op ){
+        case OP_NOP:  case OP_CPC:  case OP_ADD:  case OP_SBC:   case OP_MOVW:
+        case OP_MULS: case OP_MULSU:case OP_FMUL: case OP_FMULS: case OP_FMULSU:
+        case OP_SUB:  case OP_CP:   case OP_ADC:  case OP_AND:   case OP_EOR:
+        case OP_OR:   case OP_MOV:  case OP_CPI:  case OP_SBCI:  case OP_SUBI:
+        case OP_ORI:  case OP_ANDI: case OP_LDI:  case OP_COM:   case OP_NEG:
+        case OP_SWAP: case OP_INC:  case OP_ASR:  case OP_LSR:   case OP_ROR:
+        case OP_DEC:  case OP_ADIW: case OP_SBIW: case OP_MUL:   case OP_BLD:
+        case OP_BST:  return true;
+    }
+    return false;
+}
+
+int AvrCore::execute( avrInst_t inst ) // Execute instruction and return cycles
+{
+    const uint8_t d = inst.d;
+    const uint8_t r = inst.r;
+    const int16_t k = inst.k;
 
     uint32_t new_pc = m_PC + 1;    // future "default" pc
     m_RET_ADDR = new_pc;
     int cycle = 1;
 
-    switch( instruction & 0xf000 )
+    switch( inst.op )
     {
-        case 0x0000:{
-            switch( instruction){
-                case 0x0000: {    // NOP
-                }    break;
-                default:
-                {
-                    switch( instruction & 0xfc00) {
-                        case 0x0400: {    // CPC -- Compare with carry -- 0000 01rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd - vr - STATUS( S_C );
-                            flags_sub_Rzns( res, vd, vr );
-                        }    break;
-                        case 0x0c00: {    // ADD -- Add without carry -- 0000 11rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd + vr;
-                            m_dataMem[d] = res;
-                            flags_add_zns( res, vd, vr);
-                        }    break;
-                        case 0x0800: {    // SBC -- Subtract with carry -- 0000 10rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd - vr - STATUS( S_C );
-                            m_dataMem[d] = res;
-                            flags_sub_Rzns( res, vd, vr);
-                        }    break;
-                        default: {
-                            switch( instruction & 0xff00) {
-                                case 0x0100: {    // MOVW -- Copy Register Word -- 0000 0001 dddd rrrr
-                                    uint8_t d =( (instruction >> 4) & 0xf) << 1;
-                                    uint8_t r =( instruction & 0xf) << 1;
-                                    uint16_t vr = m_dataMem[r]|( m_dataMem[r+1] << 8);
-                                    SET_REG16_LH( d, vr );
-                                }    break;
-                                case 0x0200: {    // MULS -- Multiply Signed -- 0000 0010 dddd rrrr
-                                    int8_t r = 16 +( instruction & 0xf);
-                                    int8_t d = 16 +( (instruction >> 4) & 0xf);
-                                    int16_t res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                    SET_REG16_LH( 0, res);
-                                    /// SREG[S_C] =( res >> 15) & 1;
-                                    write_S_Bit( S_C, res & 1<<15 );
-                                    write_S_Bit( S_Z, res == 0 );
-                                    cycle++;
-                                }    break;
-                                case 0x0300: {    // MUL -- Multiply -- 0000 0011 fddd frrr
-                                    int8_t r = 16 +( instruction & 0x7);
-                                    int8_t d = 16 +( (instruction >> 4) & 0x7);
-                                    int16_t res = 0;
-                                    uint8_t c = 0;
-
-                                    switch( instruction & 0x88) {
-                                        case 0x00:     // MULSU -- Multiply Signed Unsigned -- 0000 0011 0ddd 0rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            break;
-                                        case 0x08:     // FMUL -- Fractional Multiply Unsigned -- 0000 0011 0ddd 1rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (uint8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                        case 0x80:     // FMULS -- Multiply Signed -- 0000 0011 1ddd 0rrr
-                                            res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                        case 0x88:     // FMULSU -- Multiply Signed Unsigned -- 0000 0011 1ddd 1rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                    }
-                                    cycle++;
-                                    SET_REG16_LH( 0, res);
-                                    write_S_Bit( S_C, c );
-                                    write_S_Bit( S_Z, res == 0 );
-                                }    break;
-                                default: ;//_avr_invalid_instruction(avr);
-                            }
-                        }
-                    }
-                }
-            }
+        case OP_NOP: break;
+        case OP_CPC: {    // CPC -- Compare with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr - STATUS( S_C );
+            flags_sub_Rzns( res, vd, vr );
         }    break;
-
-        case 0x1000: {
-            switch( instruction & 0xfc00) {
-                case 0x1800: {    // SUB -- Subtract without carry -- 0001 10rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd - vr;
-                    m_dataMem[d] = res;
-                    flags_sub_zns( res, vd, vr);
-                }    break;
-                case 0x1000: {    // CPSE -- Compare, skip if equal -- 0001 00rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    bool res = vd == vr;
-                    if( res )
-                    {
-                        if( is_instr_32b( new_pc ) ) { new_pc += 2; cycle += 2; }
-                        else                         { new_pc += 1; cycle++; }
-                    }
-                }    break;
-                case 0x1400: {    // CP -- Compare -- 0001 01rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd - vr;
-                    flags_sub_zns( res, vd, vr);
-                }    break;
-                case 0x1c00: {    // ADC -- Add with carry -- 0001 11rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd + vr + STATUS( S_C );
-                    m_dataMem[d] = res;
-                    flags_add_zns( res, vd, vr );
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+        case OP_ADD: {    // ADD -- Add without carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd + vr;
+            m_dataMem[d] = res;
+            flags_add_zns( res, vd, vr);
+        }    break;
+        case OP_SBC: {    // SBC -- Subtract with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr - STATUS( S_C );
+            m_dataMem[d] = res;
+            flags_sub_Rzns( res, vd, vr);
+        }    break;
+        case OP_MOVW: {    // MOVW -- Copy Register Word
+            uint16_t vr = m_dataMem[r]|( m_dataMem[r+1] << 8);
+            SET_REG16_LH( d, vr );
+        }    break;
+        case OP_MULS: {    // MULS -- Multiply Signed
+            int16_t res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+            SET_REG16_LH( 0, res);
+            write_S_Bit( S_C, res & 1<<15 );
+            write_S_Bit( S_Z, res == 0 );
+            cycle++;
+        }    break;
+        case OP_MULSU:     // MULSU  -- Multiply Signed Unsigned
+        case OP_FMUL:      // FMUL   -- Fractional Multiply Unsigned
+        case OP_FMULS:     // FMULS  -- Multiply Signed
+        case OP_FMULSU: {  // FMULSU -- Multiply Signed Unsigned
+            int16_t res = 0;
+            uint8_t c = 0;
+
+            switch( inst.op ) {
+                case OP_MULSU:
+                    res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+                    c =( res >> 15) & 1;
+                    break;
+                case OP_FMUL:
+                    res =( (uint8_t)m_dataMem[r]) *( (uint8_t)m_dataMem[d]);
+                    c =( res >> 15) & 1;
+                    res <<= 1;
+                    break;
+                case OP_FMULS:
+                    res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+                    c =( res >> 15) & 1;
+                    res <<= 1;
+                    break;
+                case OP_FMULSU:
+                    res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+                    c =( res >> 15) & 1;
+                    res <<= 1;
+                    break;
             }
+            cycle++;
+            SET_REG16_LH( 0, res);
+            write_S_Bit( S_C, c );
+            write_S_Bit( S_Z, res == 0 );
         }    break;
-
-        case 0x2000:
-        {
-            get_vd5_vr5( instruction );
-            uint8_t res = vr;
-            bool znv = true;
-            switch( instruction & 0xfc00)
+        case OP_SUB: {    // SUB -- Subtract without carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr;
+            m_dataMem[d] = res;
+            flags_sub_zns( res, vd, vr);
+        }    break;
+        case OP_CPSE: {    // CPSE -- Compare, skip if equal
+            if( m_dataMem[d] == m_dataMem[r] )
             {
-                case 0x2000: {    // AND -- Logical AND -- 0010 00rd dddd rrrr
-                    res &= vd;
-                }    break;
-                case 0x2400: {    // EOR -- Logical Exclusive OR -- 0010 01rd dddd rrrr
-                    res ^= vd;
-                }    break;
-                case 0x2800: {    // OR -- Logical OR -- 0010 10rd dddd rrrr
-                    res |= vd;
-                }    break;
-                case 0x2c00: {    // MOV -- 0010 11rd dddd rrrr
-                    //res = vr;
-                    znv = false;
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+                if( is_instr_32b( new_pc ) ) { new_pc += 2; cycle += 2; }
+                else                         { new_pc += 1; cycle++; }
             }
-            if( znv ) flags_znv0s( res);
+        }    break;
+        case OP_CP: {    // CP -- Compare
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr;
+            flags_sub_zns( res, vd, vr);
+        }    break;
+        case OP_ADC: {    // ADC -- Add with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd + vr + STATUS( S_C );
             m_dataMem[d] = res;
+            flags_add_zns( res, vd, vr );
         }    break;
-
-        case 0x3000: {    // CPI -- Compare Immediate -- 0011 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case OP_AND: {    // AND -- Logical AND
+            uint8_t res = m_dataMem[r] & m_dataMem[d];
+            flags_znv0s( res );
+            m_dataMem[d] = res;
+        }    break;
+        case OP_EOR: {    // EOR -- Logical Exclusive OR
+            uint8_t res = m_dataMem[r] ^ m_dataMem[d];
+            flags_znv0s( res );
+            m_dataMem[d] = res;
+        }    break;
+        case OP_OR: {    // OR -- Logical OR
+            uint8_t res = m_dataMem[r] | m_dataMem[d];
+            flags_znv0s( res );
+            m_dataMem[d] = res;
+        }    break;
+        case OP_MOV: {    // MOV
+            m_dataMem[d] = m_dataMem[r];
+        }    break;
+        case OP_CPI: {    // CPI -- Compare Immediate
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k;
             flags_sub_zns( res, vh, k);
         }    break;
-
-        case 0x4000: {    // SBCI -- Subtract Immediate With Carry -- 0100 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case OP_SBCI: {    // SBCI -- Subtract Immediate With Carry
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k - STATUS( S_C );
-            m_dataMem[h] = res;
+            m_dataMem[d] = res;
             flags_sub_Rzns( res, vh, k);
         }    break;
-
-        case 0x5000: {    // SUBI -- Subtract Immediate -- 0101 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case OP_SUBI: {    // SUBI -- Subtract Immediate
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k;
-            m_dataMem[h] = res;
+            m_dataMem[d] = res;
             flags_sub_zns( res, vh, k);
         }    break;
-
-        case 0x6000: {    // ORI aka SBR -- Logical OR with Immediate -- 0110 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
-            uint8_t res = vh | k;
-            m_dataMem[h] = res;
+        case OP_ORI: {    // ORI aka SBR -- Logical OR with Immediate
+            uint8_t res = m_dataMem[d] | k;
+            m_dataMem[d] = res;
             flags_znv0s( res);
         }    break;
-
-        case 0x7000: {    // ANDI    -- Logical AND with Immediate -- 0111 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
-            uint8_t res = vh & k;
-            m_dataMem[h] = res;
+        case OP_ANDI: {    // ANDI -- Logical AND with Immediate
+            uint8_t res = m_dataMem[d] & k;
+            m_dataMem[d] = res;
             flags_znv0s( res );
         }    break;
-
-        case 0xa000:
-        case 0x8000: {
-            /*
-             * Load( LDD/STD) store instructions
-             *
-             * 10q0 qqsd dddd yqqq
-             * s = 0 = load, 1 = store
-             * y = 16 bits register index, 1 = Y, 0 = X
-             * q = 6 bit displacement
-             */
-            uint16_t v = 0;
-            switch( instruction & 0xd008 )
-            {
-                case 0xa000:
-                case 0x8000: {    // LD( LDD) -- Load Indirect using Z -- 10q0 qqsd dddd yqqq
-                    v = m_dataMem[R_ZL] | ( m_dataMem[R_ZH] << 8);
-                }    break;
-                case 0xa008:
-                case 0x8008: {    // LD( LDD) -- Load Indirect using Y -- 10q0 qqsd dddd yqqq
-                    v = m_dataMem[R_YL] | ( m_dataMem[R_YH] << 8);
-                }    break;
-                //default: ;//_avr_invalid_instruction(avr);
-            }
-            get_d5_q6( instruction );
-            if( instruction & 0x0200) SET_RAM( v+q, m_dataMem[d] );
-            else                      SET_RAM( d, GET_RAM(v+q) );
+        case OP_LDD_Z:    // LD (LDD) -- Load Indirect using Z
+        case OP_LDD_Y:    // LD (LDD) -- Load Indirect using Y
+        case OP_STD_Z:    // ST (STD) -- Store Indirect using Z
+        case OP_STD_Y: {  // ST (STD) -- Store Indirect using Y
+            uint16_t v;
+            if( inst.op == OP_LDD_Z || inst.op == OP_STD_Z ) v = m_dataMem[R_ZL] | ( m_dataMem[R_ZH] << 8);
+            else                                             v = m_dataMem[R_YL] | ( m_dataMem[R_YH] << 8);
+
+            if( inst.op == OP_STD_Z || inst.op == OP_STD_Y ) SET_RAM( v+k, m_dataMem[d] );
+            else                                             SET_RAM( d, GET_RAM(v+k) );
             cycle += 1; // 2 cycles, 3 for tinyavr
         }    break;
-
-        case 0x9000: {
-            // SREG set/clear instructions
-            // SEH,SEI,SEN,SES,SET,SEV,SEZ; CLH,CLI,CLN,CLS,CLT,CLV,CLZ
-            if( (instruction & 0xff0f) == 0x9408 )
-            {
-                uint8_t bit = (instruction >> 4) & 7;
-                bool set = (instruction & 0x0080) == 0;
-                write_S_Bit( bit, set );
-                if( bit == S_I ) m_mcu->enableInterrupts( set );
+        case OP_BSET:     // SEH,SEI,SEN,SES,SET,SEV,SEZ
+        case OP_BCLR: {   // CLH,CLI,CLN,CLS,CLT,CLV,CLZ
+            bool set = inst.op == OP_BSET;
+            write_S_Bit( d, set );
+            if( d == S_I ) m_mcu->enableInterrupts( set );
+        }    break;
+        case OP_SLEEP: { // SLEEP
+            /* Don't sleep if there are interrupts about to be serviced.
+             * Without this check, it was possible to incorrectly enter a state
+             * in which the cpu was sleeping and interrupts were disabled. For more
+             * details, see the commit message. */
+            qDebug() <<"Warning: AVR SLEEP instruction not Fully implemented";
+////////     if( !int_pending.empty() || !SREG[S_I]) state = cpu_Sleeping;
+
+            m_mcu->sleep( true );
+        }    break;
+        case OP_BREAK: { // BREAK
+            qDebug() <<"ERROR: AVR BREAK instruction not implemented";
+        }    break;
+        case OP_WDR: { // WDR -- Watchdog Reset
+            m_mcu->wdr();
+        }    break;
+        case OP_SPM: { // SPM -- Store Program Memory
+            qDebug() <<"ERROR: AVR SPM instruction not implemented"; ////avr_ioctl(avr, AVR_IOCTL_FLASH_SPM, 0);
+        }    break;
+        case OP_IJMP: { // IJMP, EIJMP, ICALL, EICALL -- Indirect jump/call
+            int exte = d;  // Extended
+            int call = r;  // Call: push pc
+            uint32_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
+            if( exte ){
+                if( !EIND ){
+                    qDebug() << "ERROR: AVR Invalid instruction: EICALL with no EIND";
+                    break;
+                }
+                z |= *EIND << 16;
+            }
+            if( call ){
+                PUSH_STACK( new_pc );
+                m_RET_ADDR = new_pc;
+                cycle += m_progAddrSize-1;
+            }
+            new_pc = z;
+            cycle++;
+        }    break;
+        case OP_RETI:     // RETI -- Return from Interrupt
+            m_mcu->interrupts()->retI();// SREG flag managed in AvrInterrupt
+        case OP_RET: {    // RET -- Return
+            new_pc = POP_STACK();
+            cycle += 1 + m_progAddrSize;
+        }    break;
+        case OP_LDS: {    // LDS -- Load Direct from Data Space, 32 bits
+            uint16_t x = m_progMem[new_pc];
+            new_pc += 1;
+            m_dataMem[d] = GET_RAM(x);
+            cycle++; // 2 cycles
+        }    break;
+        case OP_LPM: {    // LPM -- Load Program Memory (to R0 if no operands)
+            uint16_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[d] = prgData & 0xFF;
+            if( r ) SET_REG16_HL( R_ZL, ++z );
+            cycle += 2; // 3 cycles
+        }    break;
+        case OP_ELPM: {    // ELPM -- Extended Load Program Memory (to R0 if no operands)
+            if( !RAMPZ){
+                qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
+                break;
             }
-            switch( instruction )
+            uint32_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[d] = prgData & 0xFF;
+            if( r ) {
+                z++;
+                m_dataMem[m_rampzAddr] = z >> 16;
+                SET_REG16_HL( R_ZL, z );
+            }
+            cycle += 2; // 3 cycles
+        }    break;
+        /*
+         * Load store instructions
+         *
+         * 1001 00sr rrrr iioo
+         * s = 0 = load, 1 = store
+         * ii = 16 bits register index, 11 = X, 10 = Y, 00 = Z
+         * oo = 1) post increment, 2) pre-decrement
+         */
+        case OP_LD_X:    // LD -- Load Indirect from Data using X
+        case OP_LD_Y:    // LD -- Load Indirect from Data using Y
+        case OP_LD_Z: {  // LD -- Load Indirect from Data using Z
+            uint8_t reg = (inst.op == OP_LD_X) ? R_XL : (inst.op == OP_LD_Y) ? R_YL : R_ZL;
+            uint16_t x = (m_dataMem[reg+1] << 8) | m_dataMem[reg];
+            cycle++; // 2 cycles( 1 for tinyavr, except with inc/dec 2)
+            if( r == 2) x--;
+            uint8_t vd = GET_RAM(x);
+            if( r == 1) x++;
+            SET_REG16_HL( reg, x);
+            m_dataMem[d] = vd;
+        }    break;
+        case OP_ST_X:    // ST -- Store Indirect Data Space X
+        case OP_ST_Y:    // ST -- Store Indirect Data Space Y
+        case OP_ST_Z: {  // ST -- Store Indirect Data Space Z
+            uint8_t reg = (inst.op == OP_ST_X) ? R_XL : (inst.op == OP_ST_Y) ? R_YL : R_ZL;
+            uint8_t vd = m_dataMem[d];
+            uint16_t x =( m_dataMem[reg+1] << 8) | m_dataMem[reg];
+            cycle++; // 2 cycles, except tinyavr
+            if( r == 2) x--;
+            SET_RAM( x, vd );
+            if( r == 1) x++;
+            SET_REG16_HL( reg, x);
+        }    break;
+        case OP_STS: {    // STS -- Store Direct to Data Space, 32 bits
+            uint8_t vd = m_dataMem[d];
+            uint16_t x = m_progMem[new_pc];
+            new_pc += 1;
+            cycle++;
+            SET_RAM( x, vd );
+        }    break;
+        case OP_POP: {    // POP
+            m_dataMem[d] = POP_STACK8();
+            cycle++;
+        }    break;
+        case OP_PUSH: {    // PUSH
+            PUSH_STACK8( m_dataMem[d] );
+            cycle++;
+        }    break;
+        case OP_COM: {    // COM -- One's Complement
+            uint8_t res = 0xff - m_dataMem[d];
+            m_dataMem[d] = res;
+            flags_znv0s( res );
+            set_S_Bit( S_C );
+        }    break;
+        case OP_NEG: {    // NEG -- Two's Complement
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = 0x00 - vd;
+            m_dataMem[d] = res;
+            write_S_Bit( S_H, ((res >> 3)|( vd >> 3)) & 1 );
+            write_S_Bit( S_V, res == 0x80 );
+            write_S_Bit( S_C, res != 0 );
+            flags_zns( res );
+        }    break;
+        case OP_SWAP: {    // SWAP -- Swap Nibbles
+            uint8_t vd = m_dataMem[d];
+            m_dataMem[d] = ( vd >> 4) | ( vd << 4);
+        }    break;
+        case OP_INC: {    // INC -- Increment
+            uint8_t res = m_dataMem[d] + 1;
+            m_dataMem[d] = res;
+            write_S_Bit( S_V, res == 0x80 );
+            flags_zns( res);
+        }    break;
+        case OP_ASR: {    // ASR -- Arithmetic Shift Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = (vd >> 1) |(vd & 0x80);
+            m_dataMem[d] = res;
+            flags_zcnvs( res, vd );
+        }    break;
+        case OP_LSR: {    // LSR -- Logical Shift Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = vd >> 1;
+            m_dataMem[d] = res;
+            clear_S_Bit( S_N );
+            flags_zcvs( res, vd);
+        }    break;
+        case OP_ROR: {    // ROR -- Rotate Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res =( STATUS(S_C) ? 0x80 : 0) | vd >> 1;
+            m_dataMem[d] = res;
+            flags_zcnvs( res, vd);
+        }    break;
+        case OP_DEC: {    // DEC -- Decrement
+            uint8_t res = m_dataMem[d] - 1;
+            m_dataMem[d] = res;
+            write_S_Bit( S_V, res == 0x7f );
+            flags_zns( res );
+        }    break;
+        case OP_JMP: {    // JMP -- Long Jump, 32 bits
+            uint16_t x = m_progMem[new_pc];
+            new_pc = ((uint32_t)k << 16) | x;
+            cycle += 2;
+        }    break;
+        case OP_CALL: {    // CALL -- Long Call to sub, 32 bits
+            uint16_t x = m_progMem[new_pc];
+            uint32_t a = ((uint32_t)k << 16) | x;
+            new_pc += 1;
+            PUSH_STACK( new_pc );
+            m_RET_ADDR = new_pc;
+            cycle += 1+m_progAddrSize;
+            new_pc = a;
+        }    break;
+        case OP_ADIW: {    // ADIW -- Add Immediate to Word
+            uint16_t vp = m_dataMem[d] | (m_dataMem[d+1] << 8);
+            uint16_t res = vp + k;
+            SET_REG16_HL( d, res );
+            write_S_Bit( S_V, (~vp & res) & (1<<15) );
+            write_S_Bit( S_C, (~res & vp) & (1<<15) );
+            flags_zns16( res );
+            cycle++;
+        }    break;
+        case OP_SBIW: {    // SBIW -- Subtract Immediate from Word
+            uint16_t vp = m_dataMem[d] | (m_dataMem[d+1] << 8);
+            uint16_t res = vp - k;
+            SET_REG16_HL( d, res );
+            write_S_Bit( S_V, (vp & ~res) & (1<<15) );
+            write_S_Bit( S_C, (res & ~vp) & (1<<15) );
+            flags_zns16( res );
+            cycle++;
+        }    break;
+        case OP_CBI: {    // CBI -- Clear Bit in I/O Register
+            uint8_t res = GET_RAM( d ) & ~r;
+            SET_RAM( d, res );
+            cycle++;
+        }    break;
+        case OP_SBIC: {    // SBIC -- Skip if Bit in I/O Register is Cleared
+            if( !(GET_RAM( d ) & r) )
             {
-                case 0x9588: { // SLEEP -- 1001 0101 1000 1000
-                    /* Don't sleep if there are interrupts about to be serviced.
-                     * Without this check, it was possible to incorrectly enter a state
-                     * in which the cpu was sleeping and interrupts were disabled. For more
-                     * details, see the commit message. */
-                    qDebug() <<"Warning: AVR SLEEP instruction not Fully implemented";
-////////             if( !int_pending.empty() || !SREG[S_I]) state = cpu_Sleeping;
-
-                    m_mcu->sleep( true );
-                }    break;
-                case 0x9598: { // BREAK -- 1001 0101 1001 1000
-                    qDebug() <<"ERROR: AVR BREAK instruction not implemented";
-                }    break;
-                case 0x95a8: { // WDR -- Watchdog Reset -- 1001 0101 1010 1000
-                    m_mcu->wdr();
-                }    break;
-                case 0x95e8: { // SPM -- Store Program Memory -- 1001 0101 1110 1000
-                    qDebug() <<"ERROR: AVR SPM instruction not implemented"; ////avr_ioctl(avr, AVR_IOCTL_FLASH_SPM, 0);
-                }    break;
-                case 0x9409:   // IJMP   -- Indirect jump -- 1001 0100 0000 1001
-                case 0x9419:   // EIJMP  -- Indirect jump -- 1001 0100 0001 1001   bit 4 is "Extended"
-                case 0x9509:   // ICALL  -- Indirect Call to Subroutine -- 1001 0101 0000 1001
-                case 0x9519: { // EICALL -- Indirect Call to Subroutine -- 1001 0101 0001 1001   bit 8 is "Call: push pc"
-                    int exte = instruction & 0x10;  // Extended
-                    int call = instruction & 0x100; // Call: push pc
-                    uint32_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
-                    if( exte ){
-                        if( !EIND ){
-                            qDebug() << "ERROR: AVR Invalid instruction: EICALL with no EIND";
-                            break;
-                        }
-                        z |= *EIND << 16;
-                    }
-                    if( call ){
-                        PUSH_STACK( new_pc );
-                        m_RET_ADDR = new_pc;
-                        cycle += m_progAddrSize-1;
-                    }
-                    new_pc = z;
-                    cycle++;
-                }    break;
-                case 0x9518:     // RETI -- Return from Interrupt -- 1001 0101 0001 1000
-                    m_mcu->interrupts()->retI();// SREG flag managed in AvrInterrupt
-                case 0x9508: {   // RET -- Return -- 1001 0101 0000 1000
-                    new_pc = POP_STACK();
-                    cycle += 1 + m_progAddrSize;
-                }    break;
-                case 0x95c8: {    // LPM -- Load Program Memory R0 <-( Z) -- 1001 0101 1100 1000
-                    uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8);
-                    cycle += 2; // 3 cycles
-                    uint16_t prgData = m_progMem[z/2];
-                    if( z&1 ) prgData >>= 8;
-                    m_dataMem[0] = prgData & 0xFF;
-                }    break;
-                case 0x95d8: {    // ELPM -- Load Program Memory R0 <-( Z) -- 1001 0101 1101 1000
-                    if( !RAMPZ){
-                        qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
-                        break;
-                    }
-                    uint32_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
-                    uint16_t prgData = m_progMem[z/2];
-                    if( z&1 ) prgData >>= 8;
-                    m_dataMem[0] = prgData & 0xFF;
-                    cycle += 2; // 3 cycles
-                }    break;
-                default:  {
-                    switch( instruction & 0xfe0f) {
-                        case 0x9000: {    // LDS -- Load Direct from Data Space, 32 bits -- 1001 0000 0000 0000
-                            get_d5( instruction );
-                            uint16_t x = m_progMem[new_pc];
-                            new_pc += 1;
-                            m_dataMem[d] = GET_RAM(x);
-                            cycle++; // 2 cycles
-                        }    break;
-                        case 0x9005:
-                        case 0x9004: {    // LPM -- Load Program Memory -- 1001 000d dddd 01oo
-                            get_d5( instruction );
-                            uint16_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
-                            int op = instruction & 1;
-                            uint16_t prgData = m_progMem[z/2];
-                            if( z&1 ) prgData >>= 8;
-                            m_dataMem[d] = prgData & 0xFF;
-                            if( op) SET_REG16_HL( R_ZL, ++z );
-                            cycle += 2; // 3 cycles
-                        }    break;
-                        case 0x9006:
-                        case 0x9007: {    // ELPM -- Extended Load Program Memory -- 1001 000d dddd 01oo
-                            if( !RAMPZ){
-                                qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
-                                break;
-                            }
-                            uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
-                            get_d5( instruction );
-                            int op = instruction & 1;
-                            uint16_t prgData = m_progMem[z/2];
-                            if( z&1 ) prgData >>= 8;
-                            m_dataMem[d] = prgData & 0xFF;
-                            if( op) {
-                                z++;
-                                m_dataMem[m_rampzAddr] = z >> 16;
-                                SET_REG16_HL( R_ZL, z );
-                            }
-                            cycle += 2; // 3 cycles
-                        }    break;
-                        /*
-                         * Load store instructions
-                         *
-                         * 1001 00sr rrrr iioo
-                         * s = 0 = load, 1 = store
-                         * ii = 16 bits register index, 11 = X, 10 = Y, 00 = Z
-                         * oo = 1) post increment, 2) pre-decrement
-                         */
-                        case 0x900c:
-                        case 0x900d:
-                        case 0x900e: {    // LD -- Load Indirect from Data using X -- 1001 000d dddd 11oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t x = (m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
-                            cycle++; // 2 cycles( 1 for tinyavr, except with inc/dec 2)
-                            if( op == 2) x--;
-                            uint8_t vd = GET_RAM(x);
-                            if( op == 1) x++;
-                            SET_REG16_HL( R_XL, x);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x920c:
-                        case 0x920d:
-                        case 0x920e: {    // ST -- Store Indirect Data Space X -- 1001 001d dddd 11oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t x =( m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
-                            cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) x--;
-                            SET_RAM( x, vd );
-                            if( op == 1) x++;
-                            SET_REG16_HL( R_XL, x);
-                        }    break;
-                        case 0x9009:
-                        case 0x900a: {    // LD -- Load Indirect from Data using Y -- 1001 000d dddd 10oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
-                            cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) y--;
-                            uint8_t vd = GET_RAM(y);
-                            if( op == 1) y++;
-                            SET_REG16_HL( R_YL, y);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x9209:
-                        case 0x920a: {    // ST -- Store Indirect Data Space Y -- 1001 001d dddd 10oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
-                             cycle++;
-                            if( op == 2) y--;
-                            SET_RAM( y, vd );
-                            if( op == 1) y++;
-                            SET_REG16_HL( R_YL, y);
-                        }    break;
-                        case 0x9200: {    // STS -- Store Direct to Data Space, 32 bits -- 1001 0010 0000 0000
-                            get_vd5( instruction );
-                            uint16_t x = m_progMem[new_pc];
-                            new_pc += 1;
-                            cycle++;
-                            SET_RAM( x, vd );
-                        }    break;
-                        case 0x9001:
-                        case 0x9002: {    // LD -- Load Indirect from Data using Z -- 1001 000d dddd 00oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
-                            cycle++;; // 2 cycles, except tinyavr
-                            if( op == 2) z--;
-                            uint8_t vd = GET_RAM(z);
-                            if( op == 1) z++;
-                            SET_REG16_HL( R_ZL, z);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x9201:
-                        case 0x9202: {    // ST -- Store Indirect Data Space Z -- 1001 001d dddd 00oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
-                             cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) z--;
-                            SET_RAM( z, vd );
-                            if( op == 1 ) z++;
-                            SET_REG16_HL( R_ZL, z);
-                        }    break;
-                        case 0x900f: {    // POP -- 1001 000d dddd 1111
-                            get_d5( instruction );
-                            m_dataMem[d] = POP_STACK8();
-                            cycle++;
-                        }    break;
-                        case 0x920f: {    // PUSH -- 1001 001d dddd 1111
-                            get_vd5( instruction );
-                            PUSH_STACK8(vd);
-                            cycle++;
-                        }    break;
-                        case 0x9400: {    // COM -- One's Complement -- 1001 010d dddd 0000
-                            get_vd5( instruction );
-                            uint8_t res = 0xff - vd;
-                            m_dataMem[d] = res;
-                            flags_znv0s( res );
-                            set_S_Bit( S_C );
-                        }    break;
-                        case 0x9401: {    // NEG -- Two's Complement -- 1001 010d dddd 0001
-                            get_vd5( instruction );
-                            uint8_t res = 0x00 - vd;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_H, ((res >> 3)|( vd >> 3)) & 1 );
-                            write_S_Bit( S_V, res == 0x80 );
-                            write_S_Bit( S_C, res != 0 );
-                            flags_zns( res );
-                        }    break;
-                        case 0x9402: {    // SWAP -- Swap Nibbles -- 1001 010d dddd 0010
-                            get_vd5( instruction );
-                            uint8_t res =( vd >> 4) | ( vd << 4) ;
-                            m_dataMem[d] = res;
-                        }    break;
-                        case 0x9403: {    // INC -- Increment -- 1001 010d dddd 0011
-                            get_vd5( instruction );
-                            uint8_t res = vd + 1;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_V, res == 0x80 );
-                            flags_zns( res);
-                        }    break;
-                        case 0x9405: {    // ASR -- Arithmetic Shift Right -- 1001 010d dddd 0101
-                            get_vd5( instruction );
-                            uint8_t res = (vd >> 1) |(vd & 0x80);
-                            m_dataMem[d] = res;
-                            flags_zcnvs( res, vd );
-                        }    break;
-                        case 0x9406: {    // LSR -- Logical Shift Right -- 1001 010d dddd 0110
-                            get_vd5( instruction );
-                            uint8_t res = vd >> 1;
-                            m_dataMem[d] = res;
-                            clear_S_Bit( S_N );
-                            flags_zcvs( res, vd);
-                        }    break;
-                        case 0x9407: {    // ROR -- Rotate Right -- 1001 010d dddd 0111
-                            get_vd5( instruction );
-                            uint8_t res =( STATUS(S_C) ? 0x80 : 0) | vd >> 1;
-                            m_dataMem[d] = res;
-                            flags_zcnvs( res, vd);
-                        }    break;
-                        case 0x940a: {    // DEC -- Decrement -- 1001 010d dddd 1010
-                            get_vd5( instruction );
-                            uint8_t res = vd - 1;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_V, res == 0x7f );
-                            flags_zns( res );
-                        }    break;
-                        case 0x940c:
-                        case 0x940d: {    // JMP -- Long Call to sub, 32 bits -- 1001 010a aaaa 110a
-                            uint32_t a =( (instruction & 0x01f0) >> 3) |( instruction & 1);
-                            uint16_t x = m_progMem[new_pc];
-                            a =( a << 16) | x;
-                            new_pc = a;
-                            cycle += 2;
-                        }    break;
-                        case 0x940e:
-                        case 0x940f: {    // CALL -- Long Call to sub, 32 bits -- 1001 010a aaaa 111a
-                            uint32_t a =( (instruction & 0x01f0) >> 3) |( instruction & 1);
-                            uint16_t x = m_progMem[new_pc];
-                            a =( a << 16) | x;
-                            new_pc += 1;
-                            PUSH_STACK( new_pc );
-                            m_RET_ADDR = new_pc;
-                            cycle += 1+m_progAddrSize;
-                            new_pc = a;
-                        }    break;
-
-                        default: {
-                            switch( instruction & 0xff00) {
-                                case 0x9600: {    // ADIW -- Add Immediate to Word -- 1001 0110 KKpp KKKK
-                                    get_vp2_k6( instruction );
-                                    uint16_t res = vp + k;
-                                    SET_REG16_HL( p, res );
-                                    /// SREG[S_V] =( (~vp & res) >> 15) & 1;
-                                    write_S_Bit( S_V, (~vp & res) & (1<<15) );
-
-                                    ///SREG[S_C] =( (~res & vp) >> 15) & 1;
-                                    write_S_Bit( S_C, (~res & vp) & (1<<15) );
-
-                                    flags_zns16( res );
-                                    cycle++;
-                                }    break;
-                                case 0x9700: {    // SBIW -- Subtract Immediate from Word -- 1001 0111 KKpp KKKK
-                                    get_vp2_k6( instruction );
-                                    uint16_t res = vp - k;
-                                    SET_REG16_HL( p, res );
-                                    /// SREG[S_V] =( (vp & ~res) >> 15) & 1;
-                                    write_S_Bit( S_V, (vp & ~res) & (1<<15) );
-
-                                    ///SREG[S_C] =( (res & ~vp) >> 15) & 1;
-                                    write_S_Bit( S_C, (res & ~vp) & (1<<15) );
-
-                                    flags_zns16( res );
-                                    cycle++;
-                                }    break;
-                                case 0x9800: {    // CBI -- Clear Bit in I/O Register -- 1001 1000 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & ~mask;
-                                    SET_RAM( io, res );
-                                    cycle++;
-                                }    break;
-                                case 0x9900: {    // SBIC -- Skip if Bit in I/O Register is Cleared -- 1001 1001 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
-                                    if( !res)
-                                    {
-                                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
-                                        else                       { new_pc += 1; cycle++; }
-                                    }
-                                }    break;
-                                case 0x9a00: {    // SBI -- Set Bit in I/O Register -- 1001 1010 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) | mask;
-                                    SET_RAM( io, res );
-                                    cycle++;
-                                }    break;
-                                case 0x9b00: {    // SBIS -- Skip if Bit in I/O Register is Set -- 1001 1011 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
-                                    if( res )
-                                    {
-                                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
-                                        else                       { new_pc += 1; cycle++; }
-                                    }
-                                }    break;
-                                default:
-                                    switch( instruction & 0xfc00) {
-                                        case 0x9c00: {    // MUL -- Multiply Unsigned -- 1001 11rd dddd rrrr
-                                            get_vd5_vr5( instruction );
-                                            uint16_t res = vd * vr;
-                                            cycle++;
-                                            SET_REG16_LH( 0, res );
-                                            write_S_Bit( S_Z, res == 0 );
-
-                                            /// SREG[S_C] =( res >> 15) & 1;
-                                            write_S_Bit( S_C, res & (1<<15) );
-                                        }    break;
-                                        default: ;//_avr_invalid_instruction(avr);
-                                    }
-                            }
-                        }    break;
-                    }
-                }    break;
+                if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
+                else                       { new_pc += 1; cycle++; }
             }
         }    break;
-
-        case 0xb000: {
-            switch( instruction & 0xf800) {
-                case 0xb800: {    // OUT A,Rr -- 1011 1AAd dddd AAAA
-                    get_d5_a6( instruction );
-                    SET_RAM( A, m_dataMem[d] );
-                }    break;
-                case 0xb000: {    // IN Rd,A -- 1011 0AAd dddd AAAA
-                    get_d5_a6( instruction );
-                    m_dataMem[d] = GET_RAM(A);
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+        case OP_SBI: {    // SBI -- Set Bit in I/O Register
+            uint8_t res = GET_RAM( d ) | r;
+            SET_RAM( d, res );
+            cycle++;
+        }    break;
+        case OP_SBIS: {    // SBIS -- Skip if Bit in I/O Register is Set
+            if( GET_RAM( d ) & r )
+            {
+                if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
+                else                       { new_pc += 1; cycle++; }
             }
         }    break;
-
-        case 0xc000: {    // RJMP -- 1100 kkkk kkkk kkkk
-            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
+        case OP_MUL: {    // MUL -- Multiply Unsigned
+            uint16_t res = m_dataMem[d] * m_dataMem[r];
+            cycle++;
+            SET_REG16_LH( 0, res );
+            write_S_Bit( S_Z, res == 0 );
+            write_S_Bit( S_C, res & (1<<15) );
+        }    break;
+        case OP_OUT: {    // OUT A,Rr
+            SET_RAM( r, m_dataMem[d] );
+        }    break;
+        case OP_IN: {    // IN Rd,A
+            m_dataMem[d] = GET_RAM( r );
+        }    break;
+        case OP_RJMP: {    // RJMP
             new_pc = (new_pc + k) % m_progSize;
             cycle++;
         }    break;
-
-        case 0xd000: {    // RCALL -- 1101 kkkk kkkk kkkk
-            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
+        case OP_RCALL: {    // RCALL
             cycle += m_progAddrSize;
             PUSH_STACK( new_pc );
             m_RET_ADDR = new_pc;
             new_pc = (new_pc + k) % m_progSize;
         }    break;
-
-        case 0xe000: {    // LDI Rd, K aka SER( LDI r, 0xff) -- 1110 kkkk dddd kkkk
-            get_h4_k8( instruction );
-            m_dataMem[h] = k;
+        case OP_LDI: {    // LDI Rd, K aka SER( LDI r, 0xff)
+            m_dataMem[d] = k;
         }    break;
-
-        case 0xf000: {
-            switch( instruction & 0xfe00)
+        case OP_BRANCH: {    // BRXC/BRXS -- All the SREG branches
+            bool set = r;
+            int branch =( STATUS(d) && set) ||( !STATUS(d) && !set);
+            if( branch) {
+                cycle++; // 2 cycles if taken, 1 otherwise
+                new_pc = new_pc + k;
+            }
+        }    break;
+        case OP_BLD: {    // BLD -- Bit Store from T into a Bit in Register
+            uint8_t v =( m_dataMem[d] & ~r) |( STATUS(S_T) ? r : 0);
+            m_dataMem[d] = v;
+        }    break;
+        case OP_BST: {    // BST -- Bit Store into T from bit in Register
+            write_S_Bit( S_T, ( m_dataMem[d] >> r) & 1 );
+        }    break;
+        case OP_SBRX: {    // SBRS/SBRC -- Skip if Bit in Register is Set/Clear
+            uint8_t vd = m_dataMem[d];
+            int set = k;
+            int branch =( (vd & r) && set) ||( !(vd & r) && !set);
+            if( branch)
             {
-                case 0xf000:
-                case 0xf200:
-                case 0xf400:
-                case 0xf600: {    // BRXC/BRXS -- All the SREG branches -- 1111 0Boo oooo osss
-                    int16_t o =( (int16_t)(instruction << 6)) >> 9; // offset
-                    uint8_t s = instruction & 7;
-                    bool set =( instruction & 0x0400) == 0;        // this bit means BRXC otherwise BRXS
-                    int branch =( STATUS(s) && set) ||( !STATUS(s) && !set);
-                    if( branch) {
-                        cycle++; // 2 cycles if taken, 1 otherwise
-                        new_pc = new_pc + o;
-                    }
-                }    break;
-                case 0xf800:
-                case 0xf900: {    // BLD -- Bit Store from T into a Bit in Register -- 1111 100d dddd 0bbb
-                    get_vd5_s3_mask( instruction );
-                    uint8_t v =( vd & ~mask) |( STATUS(S_T) ? mask : 0);
-                    m_dataMem[d] = v;
-                }    break;
-                case 0xfa00:
-                case 0xfb00:{    // BST -- Bit Store into T from bit in Register -- 1111 101d dddd 0bbb
-                    get_vd5_s3( instruction )
-                    write_S_Bit( S_T, ( vd >> s) & 1 );
-                }    break;
-                case 0xfc00:
-                case 0xfe00: {    // SBRS/SBRC -- Skip if Bit in Register is Set/Clear -- 1111 11sd dddd 0bbb
-                    get_vd5_s3_mask( instruction )
-                    int set =( instruction & 0x0200) != 0;
-                    int branch =( (vd & mask) && set) ||( !(vd & mask) && !set);
-                    if( branch)
-                    {
-                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2;}
-                        else                       { new_pc += 1; cycle++; }
-                    }   break;
-                }
-                default: ;//_avr_invalid_instruction(avr);
+                if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2;}
+                else                       { new_pc += 1; cycle++; }
             }
         }    break;
         default: ;//_avr_invalid_instruction(avr);
@@ -805,5 +823,5 @@ void AvrCore::runStep()
     if( new_pc >= m_progSize ) new_pc = 0;
 
     m_PC = new_pc;
-    m_mcu->cyclesDone = cycle;
+    return cycle;
 }
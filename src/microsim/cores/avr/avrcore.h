@@ -12,8 +12,35 @@
 #ifndef AVRCORE_H
 #define AVRCORE_H
 
+#include <vector>
+
 #include "mcucpu.h"
 
+#define AVR_BLOCK_CYCLES 16 // Max cycles of register only instructions run in one step
+
+enum avrOp_t{
+    OP_NONE=0,  // Not decoded yet
+    OP_INVALID,
+    OP_NOP,
+    OP_CPC, OP_ADD, OP_SBC, OP_MOVW, OP_MULS, OP_MULSU, OP_FMUL, OP_FMULS, OP_FMULSU,
+    OP_SUB, OP_CPSE, OP_CP, OP_ADC, OP_AND, OP_EOR, OP_OR, OP_MOV,
+    OP_CPI, OP_SBCI, OP_SUBI, OP_ORI, OP_ANDI, OP_LDI,
+    OP_LDD_Z, OP_LDD_Y, OP_STD_Z, OP_STD_Y,
+    OP_BSET, OP_BCLR, OP_SLEEP, OP_BREAK, OP_WDR, OP_SPM, OP_IJMP, OP_RETI, OP_RET,
+    OP_LDS, OP_LPM, OP_ELPM, OP_LD_X, OP_ST_X, OP_LD_Y, OP_ST_Y, OP_STS, OP_LD_Z, OP_ST_Z,
+    OP_POP, OP_PUSH, OP_COM, OP_NEG, OP_SWAP, OP_INC, OP_ASR, OP_LSR, OP_ROR, OP_DEC,
+    OP_JMP, OP_CALL, OP_ADIW, OP_SBIW,
+    OP_CBI, OP_SBIC, OP_SBI, OP_SBIS, // Same order as opcode bits 9-8
+    OP_MUL, OP_OUT, OP_IN, OP_RJMP, OP_RCALL, OP_BRANCH, OP_BLD, OP_BST, OP_SBRX
+};
+
+struct avrInst_t{  // Decoded instruction
+    uint8_t op;    // avrOp_t
+    uint8_t d;     // Destination operand
+    uint8_t r;     // Source operand, bit mask or mode
+    int16_t k;     // Constant, displacement or offset
+};
+
 class AvrCore : public McuCpu
 {
     public:
@@ -23,6 +50,8 @@ class AvrCore : public McuCpu
         //virtual void reset();
         virtual void runStep() override;
 
+        virtual void flashChanged( uint32_t addr ) override;
+
     private:
         uint16_t m_rampzAddr;
         uint8_t* RAMPZ;   // optional, only for ELPM/SPM on >64Kb cores
@@ -40,5 +69,13 @@ class AvrCore : public McuCpu
         void flags_zcvs( uint8_t res, uint8_t vr );
         void flags_zns16( uint16_t res );
         int  is_instr_32b( uint32_t pc );
+
+        avrInst_t fetch();
+        avrInst_t decode( uint16_t instruction );
+        int  execute( avrInst_t inst );
+        bool isRegOp( uint8_t op );
+        avrInst_t avrInst( uint8_t op, uint8_t d=0, uint8_t r=0, int16_t k=0 );
+
+        std::vector<avrInst_t> m_decoded; // Instructions decoded at first execution
 };
 #endif
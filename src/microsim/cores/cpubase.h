@@ -33,6 +33,8 @@ class CpuBase : public CoreBase
 
         virtual void exitSleep() {;}
 
+        virtual void flashChanged( uint32_t addr ){;} // Program memory written: drop cached decoding
+
     protected:
         eMcu* m_mcu;
 
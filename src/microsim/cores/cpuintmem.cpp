@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QStringList>
+
+#include "cpuintmem.h"
+#include "e_mcu.h"
+
+CpuIntMem::CpuIntMem( eMcu* mcu )
+{
+    m_mcu = mcu;
+    m_enabled = false;
+
+    m_data.resize( 1<<16, 0xFF );
+    m_type.resize( 1<<16, memRAM );
+}
+CpuIntMem::~CpuIntMem(){}
+
+void CpuIntMem::initialize()
+{
+    uint32_t flashSize = m_mcu->flashSize();
+    for( uint32_t i=0; i<m_data.size(); ++i )
+        m_data[i] = (i < flashSize) ? m_mcu->getFlashValue( i ) : 0xFF;
+
+    m_type.assign( m_type.size(), memRAM );
+    setType( m_romRange, memROM );
+    setType( m_extRange, memEXT );
+}
+
+void CpuIntMem::flashChanged( uint32_t addr )
+{
+    if( addr < m_data.size() ) m_data[addr] = m_mcu->getFlashValue( addr );
+}
+
+void CpuIntMem::setType( QString ranges, memType_t type ) // Ranges in hex: "start-end,start-end"
+{
+    QStringList rangeList = ranges.remove(" ").split(",");
+    for( QString range : rangeList )
+    {
+        if( range.isEmpty() ) continue;
+        QStringList limits = range.split("-");
+
+        bool ok0, ok1;
+        uint start = limits.first().toUInt( &ok0, 16 );
+        uint end   = limits.last().toUInt( &ok1, 16 );
+        if( !ok0 || !ok1 || start > end ) continue;
+        if( end >= m_type.size() ) end = m_type.size()-1;
+
+        for( uint addr=start; addr<=end; ++addr ) m_type[addr] = type;
+    }
+}
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef CPUINTMEM_H
+#define CPUINTMEM_H
+
+#include <vector>
+#include <inttypes.h>
+
+#include <QString>
+
+class eMcu;
+
+// 64 KB Memory map for CPUs with external buses (Z80, 6502).
+// Memory accesses are done internally, without driving Bus Pins,
+// except for address ranges declared as external.
+// Initial content is the Program Memory (firmware loaded in the Mcu).
+class CpuIntMem
+{
+    public:
+        CpuIntMem( eMcu* mcu );
+        ~CpuIntMem();
+
+        enum memType_t{
+            memRAM=0,
+            memROM,
+            memEXT
+        };
+
+        void initialize(); // Copy Program Memory and create memory map
+
+        bool enabled() { return m_enabled; }
+        void setEnabled( bool e ) { m_enabled = e; }
+
+        QString romRange() { return m_romRange; }
+        void setRomRange( QString r ) { m_romRange = r; }
+
+        QString extRange() { return m_extRange; }
+        void setExtRange( QString r ) { m_extRange = r; }
+
+        bool isExt( uint16_t addr ) { return m_type[addr] == memEXT; }
+
+        uint8_t read( uint16_t addr ) { return m_data[addr]; }
+        void   write( uint16_t addr, uint8_t v ) { if( m_type[addr] == memRAM ) m_data[addr] = v; }
+
+        void flashChanged( uint32_t addr ); // Firmware loaded while Simulation starting
+
+    private:
+        void setType( QString ranges, memType_t type );
+
+        bool m_enabled;
+
+        QString m_romRange; // Internal, read only: "0000-3FFF"
+        QString m_extRange; // External, drive Bus Pins: "4000-5AFF,FE00-FEFF"
+
+        std::vector<uint8_t> m_data;
+        std::vector<uint8_t> m_type;
+
+        eMcu* m_mcu;
+};
+
+#endif
@@ -29,6 +29,9 @@ I51Core::I51Core( eMcu* mcu  )
     m_acc = m_mcu->getReg( "ACC" );
 
     m_upperData = (m_dataMemEnd > m_regEnd);
+
+    m_readOpSize  = 0;
+    m_readOpIndex = 0;
 }
 I51Core::~I51Core() {}
 
@@ -185,9 +188,9 @@ void I51Core::readOperand()
     m_readPC++;
     if( --m_rCycles == 1 ) m_cpuState = cpu_EXEC; // All cycles
 
-    if( m_readOp.isEmpty() ) return; // All operands ready
+    if( m_readOpIndex == m_readOpSize ) return; // All operands ready
 
-    uint8_t addrMode = m_readOp.takeFirst();
+    uint8_t addrMode = m_readOp[m_readOpIndex++];
 
     if( addrMode & aIMME ){
         if     ( addrMode & aORIG ) m_op0 = m_pgmData;
@@ -217,19 +220,19 @@ void I51Core::readOperand()
 
 void I51Core::operRgx() { m_op0 = m_dataMem[ m_RxAddr ]; }        //
 void I51Core::operInd() { m_op0 = readInd( I_RX_VAL ); }          //
-void I51Core::operI08() { m_readOp.append( aIMME | aORIG ); }     // m_op0 = data
-void I51Core::operDir() { m_readOp.append( aDIRE | aORIG ); }     // m_op0 = GET_RAM( data );
+void I51Core::operI08() { addReadOp( aIMME | aORIG ); }           // m_op0 = data
+void I51Core::operDir() { addReadOp( aDIRE | aORIG ); }           // m_op0 = GET_RAM( data );
 void I51Core::operACC() { m_op0 = ACC; }                          //
-void I51Core::opr2I08() { m_readOp.append( aIMME | aRELA ); }     // m_op2 = data;
-void I51Core::opr2Dir() { m_readOp.append( aDIRE | aRELA ); }     // m_op2 = GET_RAM( data );
+void I51Core::opr2I08() { addReadOp( aIMME | aRELA ); }           // m_op2 = data;
+void I51Core::opr2Dir() { addReadOp( aDIRE | aRELA ); }           // m_op2 = GET_RAM( data );
 
 void I51Core::addrRgx() { m_opAddr = m_RxAddr; }
 void I51Core::addrInd() { m_opAddr = checkAddr( I_RX_VAL );}      //
-void I51Core::addrI08() { m_readOp.append( aIMME ); }             // m_opAddr = data;
-void I51Core::addrI16() { m_readOp.append( aIMME | a16BIT_HIGH);
-                          m_readOp.append( aIMME | a16BIT_LOW); } // m_opAddr = data16;
-void I51Core::addrDir() { m_readOp.append( aDIRE ); }             // m_opAddr = data;
-void I51Core::addrBit( bool invert ) { m_readOp.append( aBIT );   // m_opAddr = addr, m_op0 = bitMask
+void I51Core::addrI08() { addReadOp( aIMME ); }                   // m_opAddr = data;
+void I51Core::addrI16() { addReadOp( aIMME | a16BIT_HIGH);
+                          addReadOp( aIMME | a16BIT_LOW); }       // m_opAddr = data16;
+void I51Core::addrDir() { addReadOp( aDIRE ); }                   // m_opAddr = data;
+void I51Core::addrBit( bool invert ) { addReadOp( aBIT );         // m_opAddr = addr, m_op0 = bitMask
                                        m_invert = invert; }
 
 void I51Core::pushStack8( uint8_t value )
@@ -537,7 +540,8 @@ void I51Core::INTERRUPT( uint32_t addr )
 void I51Core::Decode()
 {
     m_rCycles = 2;     // Default 1 Instruction cycle = 2 Read cycles
-    m_readOp.clear();
+    m_readOpSize  = 0;
+    m_readOpIndex = 0;
     if( m_opcode & 8 ) // Rx
     {
         m_RxAddr = (m_opcode & 0x07) + 8*BANK;
@@ -8,6 +8,8 @@
 
 #include "mcucpu.h"
 
+#define I51_MAX_OPERS 4 // Operand read queue size: instructions have up to 2 operand bytes
+
 /*enum EM8051_EXCEPTION
 {
     EXCEPTION_STACK,             // stack address > 127 with no upper memory, or roll over
@@ -78,7 +80,9 @@ class I51Core : public McuCpu, public eElement
         uint8_t  m_opcode;
         uint8_t* m_acc;
         
-        QVector<uint8_t> m_readOp;
+        uint8_t m_readOp[I51_MAX_OPERS]; // Operand reads pending: addrMode_t flags
+        uint8_t m_readOpSize;
+        uint8_t m_readOpIndex;
         uint16_t m_opAddr;
         uint8_t m_addrMode;
         uint8_t m_op0;
@@ -146,6 +150,12 @@ class I51Core : public McuCpu, public eElement
         inline void addrDir();
         inline void addrBit( bool invert=false );
 
+        void addReadOp( uint8_t addrMode )
+        {
+            Q_ASSERT( m_readOpSize < I51_MAX_OPERS );
+            m_readOp[m_readOpSize++] = addrMode;
+        }
+
         inline uint16_t checkAddr( uint16_t addr )
         {
             if( m_upperData && (addr > m_lowDataMemEnd) ) addr += m_regEnd ;
@@ -10,9 +10,14 @@
 #include "simulator.h"
 #include "ioport.h"
 #include "watcher.h"
+#include "mcu.h"
+
+#include "boolprop.h"
+#include "stringprop.h"
 
 Mcs65Cpu::Mcs65Cpu( eMcu* mcu )
         : Mcs65Interface( mcu )
+        , m_intMem( mcu )
 {
     // CPU registers to show in Monitor
 
@@ -50,6 +55,16 @@ Mcs65Cpu::Mcs65Cpu( eMcu* mcu )
     m_soPin  = mcu->getIoPin("SO");
     /// m_dbePin = McuPort::getPin("DBE"););
 
+    m_intBus  = false;
+    m_intData = false;
+    m_dataIn  = 0;
+
+    mcu->component()->addPropGroup( { QObject::tr("Cpu"), {
+new BoolProp<Mcs65Cpu>( "Int_Mem", QObject::tr("Internal Memory")       , "", this, &Mcs65Cpu::intMem  , &Mcs65Cpu::setIntMem ),
+new StrProp <Mcs65Cpu>( "Int_ROM", QObject::tr("Internal ROM range")    , "", this, &Mcs65Cpu::romRange, &Mcs65Cpu::setRomRange ),
+new StrProp <Mcs65Cpu>( "Ext_Mem", QObject::tr("External Memory ranges"), "", this, &Mcs65Cpu::extRange, &Mcs65Cpu::setExtRange ),
+    },0} );
+
     /*mcu->component()->addPropGroup( {"Cpu", {
 new BoolProp<Mcu>( "Ext_Osc", tr("External Clock"),"", this, &Mcu::extOscEnabled, &Mcu::enableExtOsc ),
      }} );*/
@@ -84,10 +99,17 @@ void Mcs65Cpu::reset()
     m_dataMode = input;
     m_nextClock = true;
     m_halt = false;
+    m_intBus  = false;
+    m_intData = false;
 
     stamp();
 }
 
+void Mcs65Cpu::initialize()
+{
+    if( m_intMem.enabled() ) m_intMem.initialize(); // Firmware loaded later goes through flashChanged()
+}
+
 void Mcs65Cpu::stamp()
 {
     m_dataBus->reset();
@@ -154,7 +176,8 @@ void Mcs65Cpu::clkRisingEdge()
     if( m_state != cWRITE ) return;
     m_state = m_nextState;
 
-    Simulator::self()->addEvent( m_tHW, this ); // Set Data Port
+    if( m_intBus ) m_intMem.write( m_busAddr, m_op0 );
+    else           Simulator::self()->addEvent( m_tHW, this ); // Set Data Port
 }
 
 void Mcs65Cpu::clkFallingEdge()
@@ -162,6 +185,9 @@ void Mcs65Cpu::clkFallingEdge()
      m_halt = !m_rdyPin->getInpState();
     if( m_halt ) return;
 
+    m_intData = m_intBus; // Data for Address set in last cycle
+    if( m_intData ) m_dataIn = m_intMem.read( m_busAddr );
+
     m_mcu->cyclesDone = 1;
     m_cycle++;
 
@@ -199,7 +225,7 @@ void Mcs65Cpu::clkFallingEdge()
         if( m_EXEC ) (this->*m_EXEC)();
         //else qDebug() << "ERROR: Instruction not implemented: 0x"+QString::number( m_IR, 16 ).toUpper(); //
     }
-    if( m_state == cWRITE ) m_rwPin->scheduleState( false, m_tHA ); // Write result and fetch at next cycle //m_busAddr = m_opAddr Done in instruction
+    if( m_state == cWRITE ) m_rwPin->scheduleState( m_intBus, m_tHA ); // Write result and fetch at next cycle //m_busAddr = m_opAddr Done in instruction
     else{
         m_rwPin->scheduleState( true, m_tHA );
 
@@ -465,14 +491,16 @@ void Mcs65Cpu::readMem( uint16_t addr )
 {
     m_busAddr = addr;
     m_state = cREAD;
-    Simulator::self()->addEvent( m_tHA, this ); // Buses managed at runEvent()
+    m_intBus = m_intMem.enabled() && !m_intMem.isExt( addr );
+    if( !m_intBus || m_dataMode == output ) Simulator::self()->addEvent( m_tHA, this ); // Buses managed at runEvent()
 }
 
-uint8_t Mcs65Cpu::readDataBus() { return m_dataBus->getInpState(); }
+uint8_t Mcs65Cpu::readDataBus() { return m_intData ? m_dataIn : m_dataBus->getInpState(); }
 
 void Mcs65Cpu::writeMem( uint16_t addr ) {
     m_busAddr = addr; m_state = cWRITE; m_nextState = cFETCH;
-    Simulator::self()->addEvent( m_tHA, this ); // Buses managed at runEvent()
+    m_intBus = m_intMem.enabled() && !m_intMem.isExt( addr );
+    if( !m_intBus || m_dataMode == output ) Simulator::self()->addEvent( m_tHA, this ); // Buses managed at runEvent()
 }
 
 void Mcs65Cpu::pushStack8( uint8_t byte ) { m_op0 = byte; writeMem( 0x0100 + m_SP-- ); }
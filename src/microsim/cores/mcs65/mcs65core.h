@@ -7,6 +7,7 @@
 #define MCS65CPU_H
 
 #include "mcs65interface.h"
+#include "cpuintmem.h"
 #include "iopin.h"
 
 #define CONSTANT  0x20
@@ -30,6 +31,7 @@ class Mcs65Cpu : public Mcs65Interface
 
         virtual QString getStrReg( QString reg ) override;
 
+        virtual void initialize() override;
         virtual void stamp() override;
         virtual void runEvent() override;
 
@@ -39,6 +41,15 @@ class Mcs65Cpu : public Mcs65Interface
 
         virtual uint getPC() override { return m_debugPC; }
 
+        virtual void flashChanged( uint32_t addr ) override { m_intMem.flashChanged( addr ); }
+
+        bool intMem() { return m_intMem.enabled(); }
+        void setIntMem( bool i ) { m_intMem.setEnabled( i ); }
+        QString romRange() { return m_intMem.romRange(); }
+        void setRomRange( QString r ) { m_intMem.setRomRange( r ); }
+        QString extRange() { return m_intMem.extRange(); }
+        void setExtRange( QString r ) { m_intMem.setExtRange( r ); }
+
         enum { C=0,Z,I,D,B,O,V,N }; // STATUS bits
 
         enum cpuState_t{
@@ -131,6 +142,12 @@ class Mcs65Cpu : public Mcs65Interface
         uint16_t m_busAddr;
         pinMode_t m_dataMode;
 
+        // Internal Memory: Buses only driven for external addresses
+        CpuIntMem m_intMem;
+        bool m_intBus;    // m_busAddr is internal
+        bool m_intData;   // Data read in this cycle comes from internal memory
+        uint8_t m_dataIn;
+
         // Timing
         uint64_t m_tHR = 1000*10; // 10 ns Read Data Hold Time: Time to release Data Bus
         uint64_t m_tHA = 1000*25; // 25 ns Address delay Time:  Time to set Address Bus
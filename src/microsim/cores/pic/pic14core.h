@@ -25,6 +25,7 @@ protected:
             addr = m_mcu->getMapperAddr( addr+m_bank );
 
             if( addr == 0 ) addr = getINDF();// INDF
+            if( addr <= m_dataMemEnd && m_mcu->plainRead( addr ) ) return m_dataMem[addr]; // No watchers
             return McuCpu::GET_RAM( addr );
         }
         virtual void SET_RAM( uint16_t addr, uint8_t v ) override //
@@ -34,7 +35,8 @@ protected:
             if( addr == m_PCLaddr ) setPC( v + (m_dataMem[m_PCHaddr]<<8) ); // Writting to PCL
             else if( addr == 0 ) addr = getINDF();      // INDF
 
-            McuCpu::SET_RAM( addr, v );
+            if( addr <= m_dataMemEnd && m_mcu->plainWrite( addr ) ) m_dataMem[addr] = v; // No watchers
+            else McuCpu::SET_RAM( addr, v );
         }
         inline uint16_t getINDF()
         {
@@ -219,58 +219,90 @@ inline void Pic14eCore::MOVWI( uint8_t n, uint8_t k )
     }
 }
 
-void Pic14eCore::runStep( uint16_t instr )
+picInst_t Pic14eCore::decode( uint16_t instr )
 {
     if( (instr & 0x3FC0) == 0 )  // Miscellaneous instrs
     {
         if( (instr & 0x0030) == 0 ){
-            if     ( instr == 0x0001 ) reset(); // RESET 00 0000 0000 0001
-            else if( instr == 0x000A ) CALLW(); // CALLW 00 0000 0000 1010
-            else if( instr == 0x000B ) BRW();   // BRW   00 0000 0000 1011
+            if     ( instr == 0x0001 ) return picInst( PIC_RESET ); // RESET 00 0000 0000 0001
+            else if( instr == 0x000A ) return picInst( PIC_CALLW ); // CALLW 00 0000 0000 1010
+            else if( instr == 0x000B ) return picInst( PIC_BRW );   // BRW   00 0000 0000 1011
         }
         else if( (instr & 0x0030) == 1 )
         {
             uint8_t n = instr & 1<<2;
             if( (instr & 0x0008) == 0 ){
                 switch( instr & 0x0003) {
-                    case 0: MOVIW_iF( n ); return; // MOVIW ++FSRn 00 0000 0001 0n00
-                    case 1: MOVIW_dF( n ); return; // MOVIW −−FSRn 00 0000 0001 0n01
-                    case 2: MOVIW_Fi( n ); return; // MOVIW FSRn++ 00 0000 0001 0n10
-                    case 3: MOVIW_Fd( n ); return; // MOVIW FSRn−− 00 0000 0001 0n11
+                    case 0: return picInst( PIC_MOVIW_iF, n ); // MOVIW ++FSRn 00 0000 0001 0n00
+                    case 1: return picInst( PIC_MOVIW_dF, n ); // MOVIW −−FSRn 00 0000 0001 0n01
+                    case 2: return picInst( PIC_MOVIW_Fi, n ); // MOVIW FSRn++ 00 0000 0001 0n10
+                    case 3: return picInst( PIC_MOVIW_Fd, n ); // MOVIW FSRn−− 00 0000 0001 0n11
                 }
             }
             else if( (instr & 0x0008) == 1 ){
                 switch( instr & 0x0003) {
-                    case 0: MOVWI_iF( n ); return; // MOVWI ++FSRn 00 0000 0001 1n00
-                    case 1: MOVWI_dF( n ); return; // MOVWI −−FSRn 00 0000 0001 1n01
-                    case 2: MOVWI_Fi( n ); return; // MOVWI FSRn++ 00 0000 0001 1n10
-                    case 3: MOVWI_Fd( n ); return; // MOVWI FSRn−− 00 0000 0001 1n11
+                    case 0: return picInst( PIC_MOVWI_iF, n ); // MOVWI ++FSRn 00 0000 0001 1n00
+                    case 1: return picInst( PIC_MOVWI_dF, n ); // MOVWI −−FSRn 00 0000 0001 1n01
+                    case 2: return picInst( PIC_MOVWI_Fi, n ); // MOVWI FSRn++ 00 0000 0001 1n10
+                    case 3: return picInst( PIC_MOVWI_Fd, n ); // MOVWI FSRn−− 00 0000 0001 1n11
                 }
             }
         }
-        else if( (instr & 0x0020) > 0 ) MOVLB( instr & 0x1F ); // MOVLB k 00 0000 001k kkkk
+        else if( (instr & 0x0020) > 0 ) return picInst( PIC_MOVLB, 0, 0, instr & 0x1F ); // MOVLB k 00 0000 001k kkkk
     }
     else if( (instr & 0x3000) == 0x3000 ){
         uint8_t d = instr & 1<<7;
         uint8_t f = instr & 0x007F;
         // ALU operations: dest ← OP(f,W)
         switch( instr & 0x3F00 ) {
-            case 0x3500: LSLF( f, d );   return; // LSLF   f,d 11 0101 dfff ffff
-            case 0x3600: LSRF( f, d );   return; // LSRF   f,d 11 0110 dfff ffff
-            case 0x3700: ASRF( f, d );   return; // ASRF   f,d 11 0111 dfff ffff
-            case 0x3B00: SUBWFB( f, d ); return; // SUBWFB f,d 11 1011 dfff ffff
-            case 0x3D00: ADDWFC( f, d ); return; // ADDWFC f,d 11 1101 dfff ffff
+            case 0x3500: return picInst( PIC_LSLF,   f, d ); // LSLF   f,d 11 0101 dfff ffff
+            case 0x3600: return picInst( PIC_LSRF,   f, d ); // LSRF   f,d 11 0110 dfff ffff
+            case 0x3700: return picInst( PIC_ASRF,   f, d ); // ASRF   f,d 11 0111 dfff ffff
+            case 0x3B00: return picInst( PIC_SUBWFB, f, d ); // SUBWFB f,d 11 1011 dfff ffff
+            case 0x3D00: return picInst( PIC_ADDWFC, f, d ); // ADDWFC f,d 11 1101 dfff ffff
         }
         uint8_t n = instr & 1<<6;
         // Operations with literal k
         switch( instr & 0x3F80 ) {
-            case 0x3100: ADDFSR( n, instr & 0x7F ); return; // ADDFSR FSRn,k 11 0001 0nkk kkkk
-            case 0x3180: MOVLP( instr & 0x1F );     return; // MOVLP       k 11 0001 1kkk kkkk
-            case 0x3F00: MOVIW( n, instr & 0x7F );  return; // MOVIW k[FSRn] 11 1111 0nkk kkkk
-            case 0x3F80: MOVWI( n, instr & 0x7F );  return; // MOVWI k[FSRn] 11 1111 1nkk kkkk
+            case 0x3100: return picInst( PIC_ADDFSR, n, 0, instr & 0x7F ); // ADDFSR FSRn,k 11 0001 0nkk kkkk
+            case 0x3180: return picInst( PIC_MOVLP,  0, 0, instr & 0x1F ); // MOVLP       k 11 0001 1kkk kkkk
+            case 0x3F00: return picInst( PIC_MOVIW,  n, 0, instr & 0x7F ); // MOVIW k[FSRn] 11 1111 0nkk kkkk
+            case 0x3F80: return picInst( PIC_MOVWI,  n, 0, instr & 0x7F ); // MOVWI k[FSRn] 11 1111 1nkk kkkk
         }
-        if( (instr & 0x3C00) == 0x3200 ) BRA( instr & 0x1FF); // BRA k 11 001k kkkk kkkk
+        if( (instr & 0x3C00) == 0x3200 ) return picInst( PIC_BRA, 0, 0, instr & 0x1FF ); // BRA k 11 001k kkkk kkkk
     }
-    PicMrCore::runStep( instr );
+    return PicMrCore::decode( instr );
 }
 
+void Pic14eCore::execute( picInst_t inst )
+{
+    switch( inst.op )
+    {
+        case PIC_RESET:    reset();           break;
+        case PIC_CALLW:    CALLW();           break;
+        case PIC_BRW:      BRW();             break;
+        case PIC_MOVIW_iF: MOVIW_iF( inst.f ); break;
+        case PIC_MOVIW_dF: MOVIW_dF( inst.f ); break;
+        case PIC_MOVIW_Fi: MOVIW_Fi( inst.f ); break;
+        case PIC_MOVIW_Fd: MOVIW_Fd( inst.f ); break;
+        case PIC_MOVWI_iF: MOVWI_iF( inst.f ); break;
+        case PIC_MOVWI_dF: MOVWI_dF( inst.f ); break;
+        case PIC_MOVWI_Fi: MOVWI_Fi( inst.f ); break;
+        case PIC_MOVWI_Fd: MOVWI_Fd( inst.f ); break;
+        case PIC_MOVLB:    MOVLB( inst.k );    break;
+
+        case PIC_LSLF:     LSLF( inst.f, inst.d );   break;
+        case PIC_LSRF:     LSRF( inst.f, inst.d );   break;
+        case PIC_ASRF:     ASRF( inst.f, inst.d );   break;
+        case PIC_SUBWFB:   SUBWFB( inst.f, inst.d ); break;
+        case PIC_ADDWFC:   ADDWFC( inst.f, inst.d ); break;
+
+        case PIC_ADDFSR:   ADDFSR( inst.f, inst.k ); break;
+        case PIC_MOVLP:    MOVLP( inst.k );          break;
+        case PIC_BRA:      BRA( inst.k );            break;
+        case PIC_MOVIW:    MOVIW( inst.f, inst.k );  break;
+        case PIC_MOVWI:    MOVWI( inst.f, inst.k );  break;
+
+        default: PicMrCore::execute( inst );
+    }
+}
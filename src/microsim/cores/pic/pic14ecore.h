@@ -8,6 +8,14 @@
 
 #include "picmrcore.h"
 
+enum pic14eOp_t{
+    PIC_RESET = PIC_MR_END, PIC_CALLW, PIC_BRW,
+    PIC_MOVIW_iF, PIC_MOVIW_dF, PIC_MOVIW_Fi, PIC_MOVIW_Fd,
+    PIC_MOVWI_iF, PIC_MOVWI_dF, PIC_MOVWI_Fi, PIC_MOVWI_Fd, PIC_MOVLB,
+    PIC_LSLF, PIC_LSRF, PIC_ASRF, PIC_SUBWFB, PIC_ADDWFC,
+    PIC_ADDFSR, PIC_MOVLP, PIC_BRA, PIC_MOVIW, PIC_MOVWI
+};
+
 class Pic14eCore : public PicMrCore
 {
     public:
@@ -17,7 +25,8 @@ class Pic14eCore : public PicMrCore
         //virtual void reset();
 
     protected:
-        virtual void runStep( uint16_t instr ) override;
+        virtual picInst_t decode( uint16_t instr ) override;
+        virtual void execute( picInst_t inst ) override;
         virtual void setBank( uint8_t bank ) override { PicMrCore::setBank( bank ); }
 
         uint8_t* m_FSR0L;
@@ -61,6 +70,7 @@ class Pic14eCore : public PicMrCore
                      return m_progMem[addr];
                 }
             }
+            if( addr <= m_dataMemEnd && m_mcu->plainRead( addr ) ) return m_dataMem[addr]; // No watchers
             return McuCpu::GET_RAM( addr );
         }
         virtual void SET_RAM( uint16_t addr, uint8_t v ) override //
@@ -69,7 +79,9 @@ class Pic14eCore : public PicMrCore
             if( addr == m_PCLaddr ) setPC( v + (m_dataMem[m_PCHaddr]<<8) ); // Writting to PCL
             else if( addr == 0 ) addr = getFSR0(); // INDF0
             else if( addr == 1 ) addr = getFSR1(); // INDF1
-            McuCpu::SET_RAM( addr, v );
+
+            if( addr <= m_dataMemEnd && m_mcu->plainWrite( addr ) ) m_dataMem[addr] = v; // No watchers
+            else McuCpu::SET_RAM( addr, v );
         }
 
         // Miscellaneous instructions
@@ -15,6 +15,8 @@ PicMrCore::PicMrCore( eMcu* mcu )
 
     m_PCLaddr = mcu->getRegAddress("PCL");
     m_PCHaddr = mcu->getRegAddress("PCLATH");
+
+    m_decoded.resize( m_progSize, picInst( PIC_NONE ) );
 }
 PicMrCore::~PicMrCore() {}
 
@@ -264,35 +266,32 @@ inline void PicMrCore::ADDLW( uint8_t k ) //// C,DC,Z
     *m_Wreg = add( k, *m_Wreg );
 }
 
+void PicMrCore::flashChanged( uint32_t addr )
+{
+    if( addr < m_decoded.size() ) m_decoded[addr].op = PIC_NONE; // Decode again at next execution
+}
+
 void PicMrCore::runStep()
 {
-    uint16_t instr = m_progMem[m_PC] & 0x3FFF;
+    picInst_t inst = m_decoded[m_PC];
+    if( inst.op == PIC_NONE ) inst = m_decoded[m_PC] = decode( m_progMem[m_PC] & 0x3FFF );
 
     m_mcu->cyclesDone = 0;
     incDefault();
     m_RET_ADDR = m_PC;
 
-    runStep( instr );
+    execute( inst );
 }
 
-void PicMrCore::runStep( uint16_t instr )
+picInst_t PicMrCore::decode( uint16_t instr )
 {
     if( (instr & 0x3F80) == 0 )  // Miscellaneous instrs
     {
-        switch( instr & 0x000C)
-        {
-            case 0x0008: {
-                if     ( instr == 0x0008 ) RETURN(); // RETURN 00 0000 0000 1000
-                else if( instr == 0x0009 ) RETFIE(); // RETFIE 00 0000 0000 1001
-            } return;
-            case 0x0000: {
-                if     ( instr == 0x0062 ) OPTION(); // OPTION 00 0000 0110 0010
-                else if( instr == 0x0063 ) SLEEP();  // SLEEP  00 0000 0110 0011
-            } return;
-            case 0x0004: {
-                if     ( instr == 0x0064 ) CLRWDT(); // CLRWDT 00 0000 0110 0100
-            } return;
-        }
+        if     ( instr == 0x0008 ) return picInst( PIC_RETURN ); // RETURN 00 0000 0000 1000
+        else if( instr == 0x0009 ) return picInst( PIC_RETFIE ); // RETFIE 00 0000 0000 1001
+        else if( instr == 0x0062 ) return picInst( PIC_OPTION ); // OPTION 00 0000 0110 0010
+        else if( instr == 0x0063 ) return picInst( PIC_SLEEP );  // SLEEP  00 0000 0110 0011
+        else if( instr == 0x0064 ) return picInst( PIC_CLRWDT ); // CLRWDT 00 0000 0110 0100
     }
     else if( (instr & 0x3000) == 0 ) // ALU operations: dest ← OP(f,W)
     {
@@ -301,66 +300,111 @@ void PicMrCore::runStep( uint16_t instr )
 
         if( (instr & 0x3800) == 0 ) {
             switch( instr & 0x0700) {
-                case 0x0000: MOVWF( f );    return; // MOVWF f   00 0000 1fff ffff
-                case 0x0100: CLRF( f );     return; // CLR   f   00 0001 1fff ffff
-                case 0x0200: SUBWF( f, d ); return; // SUBWF f,d 00 0010 dfff ffff
-                case 0x0300: DECF( f, d );  return; // DECF  f,d 00 0011 dfff ffff
-                case 0x0400: IORWF( f, d ); return; // IORWF f,d 00 0100 dfff ffff
-                case 0x0500: ANDWF( f, d ); return; // ANDWF f,d 00 0101 dfff ffff
-                case 0x0600: XORWF( f, d ); return; // XORWF f,d 00 0110 dfff ffff
-                case 0x0700: ADDWF( f, d ); return; // ADDWF f,d 00 0111 dfff ffff
+                case 0x0000: return picInst( PIC_MOVWF, f );    // MOVWF f   00 0000 1fff ffff
+                case 0x0100: return picInst( PIC_CLRF,  f );    // CLR   f   00 0001 1fff ffff
+                case 0x0200: return picInst( PIC_SUBWF, f, d ); // SUBWF f,d 00 0010 dfff ffff
+                case 0x0300: return picInst( PIC_DECF,  f, d ); // DECF  f,d 00 0011 dfff ffff
+                case 0x0400: return picInst( PIC_IORWF, f, d ); // IORWF f,d 00 0100 dfff ffff
+                case 0x0500: return picInst( PIC_ANDWF, f, d ); // ANDWF f,d 00 0101 dfff ffff
+                case 0x0600: return picInst( PIC_XORWF, f, d ); // XORWF f,d 00 0110 dfff ffff
+                case 0x0700: return picInst( PIC_ADDWF, f, d ); // ADDWF f,d 00 0111 dfff ffff
            }
         } else {
             switch( instr & 0x0700) {
-                case 0x0000: MOVF( f, d );   return; // MOVF   f,d 00 1000 dfff ffff
-                case 0x0100: COMF( f, d );   return; // COMF   f,d 00 0001 dfff ffff
-                case 0x0200: INCF( f, d );   return; // INCF   f,d 00 0010 dfff ffff
-                case 0x0300: DECFSZ( f, d ); return; // DECFSZ f,d 00 0011 dfff ffff
-                case 0x0400: RRF( f, d );    return; // RRF    f,d 00 0100 dfff ffff
-                case 0x0500: RLF( f, d );    return; // RLF    f,d 00 0101 dfff ffff
-                case 0x0600: SWAPF( f, d );  return; // SWAPF  f,d 00 0110 dfff ffff
-                case 0x0700: INCFSZ( f, d ); return; // INCFSZ f,d 00 0111 dfff ffff
+                case 0x0000: return picInst( PIC_MOVF,   f, d ); // MOVF   f,d 00 1000 dfff ffff
+                case 0x0100: return picInst( PIC_COMF,   f, d ); // COMF   f,d 00 0001 dfff ffff
+                case 0x0200: return picInst( PIC_INCF,   f, d ); // INCF   f,d 00 0010 dfff ffff
+                case 0x0300: return picInst( PIC_DECFSZ, f, d ); // DECFSZ f,d 00 0011 dfff ffff
+                case 0x0400: return picInst( PIC_RRF,    f, d ); // RRF    f,d 00 0100 dfff ffff
+                case 0x0500: return picInst( PIC_RLF,    f, d ); // RLF    f,d 00 0101 dfff ffff
+                case 0x0600: return picInst( PIC_SWAPF,  f, d ); // SWAPF  f,d 00 0110 dfff ffff
+                case 0x0700: return picInst( PIC_INCFSZ, f, d ); // INCFSZ f,d 00 0111 dfff ffff
             }
         }
-    } else {
-        if( (instr & 0x3000) == 0x1000 ) // Bit operations
-        {
-            uint8_t f = instr & 0x7F;
-            uint8_t b = instr>>7 & 7;
-
-            switch( instr & 0x3C00){
-                case 0x1000: BCF( f, b );   return; // BCF   f,b 01 00bb bkkk kkkk
-                case 0x1400: BSF( f, b );   return; // BSF   f,b 01 01bb bkkk kkkk
-                case 0x1800: BTFSC( f, b ); return; // BTFSC f,b 01 10bb bkkk kkkk
-                case 0x1C00: BTFSS( f, b ); return; // BTFSS f,b 01 11bb bkkk kkkk
-            }
-        }
-        else if( (instr & 0x3000) == 0x2000 ) // Control transfers
-        {
-            uint16_t k = instr & 0x07FF;
+    }
+    else if( (instr & 0x3000) == 0x1000 ) // Bit operations
+    {
+        uint8_t f = instr & 0x7F;
+        uint8_t b = instr>>7 & 7;
 
-            if( (instr & 0x0800) == 0 ) CALL( k ); // CALL k 10 0kkk kkkk kkkk
-            else                        GOTO( k ); // GOTO k 10 1kkk kkkk kkkk
+        switch( instr & 0x3C00){
+            case 0x1000: return picInst( PIC_BCF,   f, b ); // BCF   f,b 01 00bb bkkk kkkk
+            case 0x1400: return picInst( PIC_BSF,   f, b ); // BSF   f,b 01 01bb bkkk kkkk
+            case 0x1800: return picInst( PIC_BTFSC, f, b ); // BTFSC f,b 01 10bb bkkk kkkk
+            case 0x1C00: return picInst( PIC_BTFSS, f, b ); // BTFSS f,b 01 11bb bkkk kkkk
         }
-        else if( (instr & 0x3000) == 0x3000 ) // Operations with W and 8-bit literal: W ← OP(k,W)
-        {
-            uint8_t k = instr & 0xFF;
-
-            switch( instr & 0x3C00){
-                case 0x3000: MOVLW( k ); return; // MOVLW k 11 00xx kkkk kkkk
-                case 0x3400: RETLW( k ); return; // RETLW k 11 01xx kkkk kkkk
-                case 0x3800: {
-                    switch( instr & 0x3F00) {
-                        case 0x3800: IORLW( k ); return; // IORLW k 11 1000 kkkk kkkk
-                        case 0x3900: ANDLW( k ); return; // ANDLW k 11 1001 kkkk kkkk
-                        case 0x3A00: XORLW( k ); return; // XORLW k 11 1010 kkkk kkkk
-                    }
-                } return;
-                case 0x3C00: {
-                    if((instr & 0x0200)==0 ) SUBLW( k ); // SUBLW k 11 110x kkkk kkkk
-                    else                     ADDLW( k ); // ADDLW k 11 111x kkkk kkkk
+    }
+    else if( (instr & 0x3000) == 0x2000 ) // Control transfers
+    {
+        uint16_t k = instr & 0x07FF;
+
+        if( (instr & 0x0800) == 0 ) return picInst( PIC_CALL, 0, 0, k ); // CALL k 10 0kkk kkkk kkkk
+        else                        return picInst( PIC_GOTO, 0, 0, k ); // GOTO k 10 1kkk kkkk kkkk
+    }
+    else if( (instr & 0x3000) == 0x3000 ) // Operations with W and 8-bit literal: W ← OP(k,W)
+    {
+        uint8_t k = instr & 0xFF;
+
+        switch( instr & 0x3C00){
+            case 0x3000: return picInst( PIC_MOVLW, 0, 0, k ); // MOVLW k 11 00xx kkkk kkkk
+            case 0x3400: return picInst( PIC_RETLW, 0, 0, k ); // RETLW k 11 01xx kkkk kkkk
+            case 0x3800: {
+                switch( instr & 0x3F00) {
+                    case 0x3800: return picInst( PIC_IORLW, 0, 0, k ); // IORLW k 11 1000 kkkk kkkk
+                    case 0x3900: return picInst( PIC_ANDLW, 0, 0, k ); // ANDLW k 11 1001 kkkk kkkk
+                    case 0x3A00: return picInst( PIC_XORLW, 0, 0, k ); // XORLW k 11 1010 kkkk kkkk
                 }
+            } break;
+            case 0x3C00: {
+                if((instr & 0x0200)==0 ) return picInst( PIC_SUBLW, 0, 0, k ); // SUBLW k 11 110x kkkk kkkk
+                else                     return picInst( PIC_ADDLW, 0, 0, k ); // ADDLW k 11 111x kkkk kkkk
             }
         }
     }
+    return picInst( PIC_NOP );
+}
+
+void PicMrCore::execute( picInst_t inst )
+{
+    switch( inst.op )
+    {
+        case PIC_RETURN: RETURN(); break;
+        case PIC_RETFIE: RETFIE(); break;
+        case PIC_OPTION: OPTION(); break;
+        case PIC_SLEEP:  SLEEP();  break;
+        case PIC_CLRWDT: CLRWDT(); break;
+
+        case PIC_MOVWF:  MOVWF( inst.f );          break;
+        case PIC_CLRF:   CLRF( inst.f );           break;
+        case PIC_SUBWF:  SUBWF( inst.f, inst.d );  break;
+        case PIC_DECF:   DECF( inst.f, inst.d );   break;
+        case PIC_IORWF:  IORWF( inst.f, inst.d );  break;
+        case PIC_ANDWF:  ANDWF( inst.f, inst.d );  break;
+        case PIC_XORWF:  XORWF( inst.f, inst.d );  break;
+        case PIC_ADDWF:  ADDWF( inst.f, inst.d );  break;
+        case PIC_MOVF:   MOVF( inst.f, inst.d );   break;
+        case PIC_COMF:   COMF( inst.f, inst.d );   break;
+        case PIC_INCF:   INCF( inst.f, inst.d );   break;
+        case PIC_DECFSZ: DECFSZ( inst.f, inst.d ); break;
+        case PIC_RRF:    RRF( inst.f, inst.d );    break;
+        case PIC_RLF:    RLF( inst.f, inst.d );    break;
+        case PIC_SWAPF:  SWAPF( inst.f, inst.d );  break;
+        case PIC_INCFSZ: INCFSZ( inst.f, inst.d ); break;
+
+        case PIC_BCF:    BCF( inst.f, inst.d );    break;
+        case PIC_BSF:    BSF( inst.f, inst.d );    break;
+        case PIC_BTFSC:  BTFSC( inst.f, inst.d );  break;
+        case PIC_BTFSS:  BTFSS( inst.f, inst.d );  break;
+
+        case PIC_CALL:   CALL( inst.k ); break;
+        case PIC_GOTO:   GOTO( inst.k ); break;
+
+        case PIC_MOVLW:  MOVLW( inst.k ); break;
+        case PIC_RETLW:  RETLW( inst.k ); break;
+        case PIC_IORLW:  IORLW( inst.k ); break;
+        case PIC_ANDLW:  ANDLW( inst.k ); break;
+        case PIC_XORLW:  XORLW( inst.k ); break;
+        case PIC_SUBLW:  SUBLW( inst.k ); break;
+        case PIC_ADDLW:  ADDLW( inst.k ); break;
+    }
 }
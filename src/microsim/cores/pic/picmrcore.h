@@ -6,12 +6,33 @@
 #ifndef PICMRCORE_H
 #define PICMRCORE_H
 
+#include <vector>
+
 #include "mcucpu.h"
 
 enum {
     C=0,DC,Z,PD,TO,RP0,RP1,IRP
 };
 
+enum picOp_t{
+    PIC_NONE=0,  // Not decoded yet
+    PIC_NOP,
+    PIC_RETURN, PIC_RETFIE, PIC_OPTION, PIC_SLEEP, PIC_CLRWDT,
+    PIC_MOVWF, PIC_CLRF, PIC_SUBWF, PIC_DECF, PIC_IORWF, PIC_ANDWF, PIC_XORWF, PIC_ADDWF,
+    PIC_MOVF, PIC_COMF, PIC_INCF, PIC_DECFSZ, PIC_RRF, PIC_RLF, PIC_SWAPF, PIC_INCFSZ,
+    PIC_BCF, PIC_BSF, PIC_BTFSC, PIC_BTFSS,
+    PIC_CALL, PIC_GOTO,
+    PIC_MOVLW, PIC_RETLW, PIC_IORLW, PIC_ANDLW, PIC_XORLW, PIC_SUBLW, PIC_ADDLW,
+    PIC_MR_END   // Enhanced core operations start here
+};
+
+struct picInst_t{  // Decoded instruction
+    uint8_t  op;   // picOp_t or enhanced core op
+    uint8_t  f;    // File register (bank independent) or FSR index
+    uint8_t  d;    // Destination or bit
+    uint16_t k;    // Literal or address
+};
+
 class PicMrCore : public McuCpu
 {
     public:
@@ -23,8 +44,23 @@ class PicMrCore : public McuCpu
 
         virtual uint RET_ADDR() override { return m_stack[m_sp]; }
 
+        virtual void flashChanged( uint32_t addr ) override;
+
     protected:
-        virtual void runStep( uint16_t instr );
+        virtual picInst_t decode( uint16_t instr );
+        virtual void execute( picInst_t inst );
+
+        picInst_t picInst( uint8_t op, uint8_t f=0, uint8_t d=0, uint16_t k=0 )
+        {
+            picInst_t inst;
+            inst.op = op;
+            inst.f  = f;
+            inst.d  = d;
+            inst.k  = k;
+            return inst;
+        }
+        std::vector<picInst_t> m_decoded; // Instructions decoded at first execution
+
         uint8_t* m_Wreg;
         uint8_t* m_OPTION;
 
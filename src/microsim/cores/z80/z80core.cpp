@@ -31,6 +31,7 @@
 Z80Core::Z80Core( eMcu* mcu )
        : CpuBase( mcu )
        , eElement( mcu->getId()+"-Z80Core" )
+       , m_intMem( mcu )
 {
     // Values to show in Monitor High Area (any type)
     mcu->createWatcher( this );
@@ -88,6 +89,7 @@ Z80Core::Z80Core( eMcu* mcu )
     m_intVector = false;                 // interrupt vector for mode 2 is read from data bus
 
     m_delay = 10e3; // 10 ns
+    m_extBus = true;
 
     m_dataPort = mcu->getIoPort("PORTD");
     m_addrPort = mcu->getIoPort("PORTA");
@@ -119,6 +121,9 @@ new StrProp <Z80Core>( "Producer"        , QObject::tr("Producer")             ,
 new BoolProp<Z80Core>( "CMOS"            , QObject::tr("CMOS")                 , "", this, &Z80Core::cmos     , &Z80Core::setCmos ),
 new BoolProp<Z80Core>( "Single cycle I/O", QObject::tr("Single cycle I/O")     , "", this, &Z80Core::ioWait   , &Z80Core::setIoWait ),
 new BoolProp<Z80Core>( "Int_Vector"      , QObject::tr("Interrupt Vector 0xFF"), "", this, &Z80Core::intVector, &Z80Core::setIntVector ),
+new BoolProp<Z80Core>( "Int_Mem"         , QObject::tr("Internal Memory")      , "", this, &Z80Core::intMem   , &Z80Core::setIntMem ),
+new StrProp <Z80Core>( "Int_ROM"         , QObject::tr("Internal ROM range")   , "", this, &Z80Core::romRange , &Z80Core::setRomRange ),
+new StrProp <Z80Core>( "Ext_Mem"         , QObject::tr("External Memory ranges"), "", this, &Z80Core::extRange, &Z80Core::setExtRange ),
     },0} );
 }
 
@@ -453,6 +458,11 @@ QString Z80Core::getStrReg16( uint8_t reg )
     return strReg16;
 }
 
+void Z80Core::initialize()
+{
+    if( m_intMem.enabled() ) m_intMem.initialize(); // Firmware loaded later goes through flashChanged()
+}
+
 void Z80Core::stamp()
 {
     m_mreqPin->setOutStatFast( true );
@@ -543,6 +553,8 @@ void Z80Core::reset()
     sDI = 0x00;
     sDO = 0x00;
     sAO = 0x0000;
+
+    m_extBus = true;
 }
 
 void Z80Core::extClock( bool clkState ) // External Clock
@@ -607,8 +619,12 @@ void Z80Core::clkRisingEdge() // Execution of instruction and sampling bus signa
     sInt    = !m_intPin->getInpState();
     sBusReq = !m_busreqPin->getInpState(); /// At Rising edge latst T State ??? - I guess it doesn't matter
 
-    // RisingEdgeDelayed
-    Simulator::self()->addEvent( m_delay, this );
+    if( extCycle() )
+    {
+        m_extBus = true;
+        Simulator::self()->addEvent( m_delay, this ); // RisingEdgeDelayed
+    }
+    else intRisingEdge();
 }
 
 void Z80Core::clkFallingEdge() // Sampling bus signal at clock falling edge
@@ -621,8 +637,8 @@ void Z80Core::clkFallingEdge() // Sampling bus signal at clock falling edge
         sDI = readDataBus();
     }*/
 
-    // FallingEdgeDelayed
-    Simulator::self()->addEvent( m_delay, this );
+    if( m_extBus ) Simulator::self()->addEvent( m_delay, this ); // FallingEdgeDelayed
+    else           intFallingEdge();
 }
 
 // Increasing TState, if it is last TState then TState is reset and MCycle is increased
@@ -824,6 +840,46 @@ void Z80Core::fallingEdgeDelayed()
     else if( !sBusReq ) m_busacPin->setOutStatFast( true ); // If bus is not requested any more by BUSRQ signal then signal BUSACK is reset
 }
 
+// Internal Memory: memory cycles out of external ranges don't drive Bus Pins
+// I/O and Interrupt Acknowledge cycles always use the external Bus
+bool Z80Core::extCycle()
+{
+    if( !m_intMem.enabled() || sBusAck || normalReset || highImpedanceBus ) return true;
+    if( m_extBus && (sm_TState != 1 || sm_waitTState) ) return true; // External until Machine cycle finished
+
+    switch( mc_busOp ){
+        case oNone:     return false;
+        case oM1:
+        case oMemRead:
+        case oMemWrite: return m_intMem.isExt( sAO );
+        default:        return true;
+    }
+}
+
+void Z80Core::intRisingEdge()
+{
+    if( sm_TState == 1 && m_extBus ) // Previous Machine cycle was external: release Bus as risingEdgeDelayed()
+    {
+        if( m_lastBusOp == oMemWrite || m_lastBusOp == oIOWrite ) m_dataPort->setPinMode( input );
+        if( m_lastBusOp == oM1 || m_lastBusOp == oIntAck  ) m_rfshPin->setOutStatFast( true );
+        m_extBus = false;
+    }
+    else if( sm_TState == 3 && mc_busOp == oM1 ) regR = ( (regR + 1) & 0x7f ) + ( regR & 0x80 ); // Memory refresh
+}
+
+void Z80Core::intFallingEdge()
+{
+    switch( sm_TState ){
+        case 3: if     ( mc_busOp == oMemRead  ) sDI = m_intMem.read( sAO );
+                else if( mc_busOp == oMemWrite ) m_intMem.write( sAO, sDO );
+                break;
+        case 4: if( m_iReg == 0x76 && m_iSet == noPrefix ) m_haltPin->setOutStatFast( false ); // Same as fallingEdgeDelayed()
+                if( sNMI || ( sInt && IFF1 ) )             m_haltPin->setOutStatFast( true );
+    }
+}
+
+uint8_t Z80Core::readDataBus() { return m_extBus ? m_dataPort->getInpState() : m_intMem.read( sAO ); }
+
 void Z80Core::releaseBus( bool rel )
 {
     pinMode_t mode = rel ? input : output;
@@ -858,7 +914,7 @@ void Z80Core::opCodeFetch()
 
     switch( sm_M1CycleType ) // Fetching opcode
     {
-        case tOpCodeFetch: m_iReg = m_dataPort->getInpState();   // reading opcode from data bus
+        case tOpCodeFetch: m_iReg = readDataBus();              // reading opcode from data bus or internal memory
             m_PC++;                                            // increase program counter PC
 
             // Set number of machine cycles and TStates for instruction
@@ -22,6 +22,7 @@
 
 #include "cpubase.h"
 #include "e-element.h"
+#include "cpuintmem.h"
 #include "z80regs.h"
 
 #define Z80CORE_MAX_T_INT 1000000   // Maximum T cycles after interrupt
@@ -32,6 +33,7 @@ class Z80Core : public CpuBase, public eElement
         Z80Core( eMcu* mcu );
         ~Z80Core();
 
+        virtual void initialize() override;
         virtual void stamp() override;
         virtual void runEvent() override;
 
@@ -42,6 +44,8 @@ class Z80Core : public CpuBase, public eElement
         virtual int getCpuReg( QString reg ) override;
         virtual QString getStrReg( QString reg ) override;
 
+        virtual void flashChanged( uint32_t addr ) override { m_intMem.flashChanged( addr ); }
+
         QString getStrInst();
         QString getStrMathOp( uint8_t reg );
         QString getStrFlag( uint8_t reg );
@@ -59,12 +63,27 @@ class Z80Core : public CpuBase, public eElement
         void setIoWait( bool ioWait );
         bool intVector() { return m_intVector; }
         void setIntVector( bool intVector );
+        bool intMem() { return m_intMem.enabled(); }
+        void setIntMem( bool i ) { m_intMem.setEnabled( i ); }
+        QString romRange() { return m_intMem.romRange(); }
+        void setRomRange( QString r ) { m_intMem.setRomRange( r ); }
+        QString extRange() { return m_intMem.extRange(); }
+        void setExtRange( QString r ) { m_intMem.setExtRange( r ); }
 
     private:
         void risingEdgeDelayed();
         void fallingEdgeDelayed();
         void releaseBus( bool rel );
 
+        // Internal Memory: Bus Pins only driven in external cycles
+        inline bool extCycle();
+        inline void intRisingEdge();
+        inline void intFallingEdge();
+        inline uint8_t readDataBus();
+
+        CpuIntMem m_intMem;
+        bool m_extBus;    // Bus Pins driven in this machine cycle
+
         // Setting of Z80Core
         enum eProducer { pZilog = 0, pNec, pSt };
         eProducer m_producer;
@@ -132,10 +132,20 @@ void eMcu::runEvent()
     }
     else if( m_state >= mcuRunning && m_freq > 0 )
     {
-        stepCpu();
-        int cycles = cyclesDone;
-        if( cycles == 0 ) cycles = 1;                        // 8051: 2 Read cycles per Machine cycle
-        Simulator::self()->addEvent( cycles*m_psTick, this );
+        bool quantum = Simulator::self()->mcuQuantum();
+        uint64_t time;
+        while( true ) // Quantum: run instructions until next event, circuit change or Register Signal
+        {
+            m_sigAccess = false;
+            stepCpu();
+            int cycles = cyclesDone;
+            if( cycles == 0 ) cycles = 1;                    // 8051: 2 Read cycles per Machine cycle
+            time = cycles*m_psTick;
+
+            if( !quantum || m_sigAccess || m_state != mcuRunning ) break;
+            if( !Simulator::self()->advanceTime( time ) ) break; // Next instruction at it's time
+        }
+        Simulator::self()->addEvent( time, this );
     }
 }
 
@@ -227,6 +237,12 @@ void eMcu::setEeprom( QVector<int>* eep )
     for( int i=0; i<size; ++i ) setRomValue( i, eep->at(i) );
 }
 
+void eMcu::setFlashValue( int address, uint16_t value )
+{
+    m_progMem[address] = value;
+    if( m_cpu ) m_cpu->flashChanged( address );
+}
+
 McuTimer* eMcu::getTimer( QString name )
 {
     McuTimer* timer = m_timerList.value( name );
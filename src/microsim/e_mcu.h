@@ -63,9 +63,10 @@ class eMcu : public DataSpace, public eIou
 
         void setDebugger( BaseDebugger* deb );
         void setDebugging( bool d );
+        bool isDebugging() { return m_debugging; }
 
         uint16_t getFlashValue( int address ) { return m_progMem[address]; }
-        void     setFlashValue( int address, uint16_t value ) { m_progMem[address] = value; }
+        void     setFlashValue( int address, uint16_t value );
         uint32_t flashSize(){ return m_flashSize; }
         uint32_t wordSize() { return m_wordSize; }
 
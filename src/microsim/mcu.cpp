@@ -137,7 +137,7 @@ Mcu::Mcu( QString type, QString id )
     else if( QFile::exists( dataFile ) ) // MCU defined in xml file
     {
         QString xmlFile = dataFile;
-        QDomDocument domDoc = fileToDomDoc( xmlFile, "Mcu::Mcu" );
+        QDomDocument domDoc = cachedDomDoc( xmlFile, "Mcu::Mcu" );
         if( domDoc.isNull() ) { m_error = 1; return; }
 
         QDomElement root  = domDoc.documentElement();
@@ -191,13 +191,11 @@ Mcu::Mcu( QString type, QString id )
 
         QString pkgeFile = baseFile+".package";
         if( QFileInfo::exists( pkgeFile ) ){
-            QString pkgStr = fileToString( pkgeFile, "Mcu::Mcu" );
-            m_packageList["1- "+m_device+"_DIP"] = convertPackage( pkgStr );
+            m_packageList["1- "+m_device+"_DIP"] = loadPackage( pkgeFile );
         }
         QString pkgFileLS = baseFile+"_LS.package";
         if( QFileInfo::exists( pkgFileLS ) ){
-            QString pkgStr = fileToString( pkgFileLS, "Mcu::Mcu" );
-            m_packageList["2- "+m_device+"_LS"] = convertPackage( pkgStr );
+            m_packageList["2- "+m_device+"_LS"] = loadPackage( pkgFileLS );
         }
     }
 
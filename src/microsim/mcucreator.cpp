@@ -122,13 +122,15 @@ int McuCreator::createMcu( Mcu* mcuComp, QString name )
 
     if( error == 0 ) m_mcuComp->setupMcu();
 
+    mcu->freezeSignals(); // Register watchers are set, pack Signal slots
+
     return error;
 }
 
 int McuCreator::processFile( QString fileName )
 {
     fileName = m_basePath+"/"+fileName;
-    QDomDocument domDoc = fileToDomDoc( fileName, "McuCreator::processFile" );
+    QDomDocument domDoc = cachedDomDoc( fileName, "McuCreator::processFile" );
     if( domDoc.isNull() ) return 1;
 
     QDomElement root = domDoc.documentElement();
@@ -322,6 +324,7 @@ void McuCreator::createDataMem( uint32_t size )
     mcu->m_ramSize = size;
     mcu->m_dataMem.resize( size, 0 );
     mcu->m_addrMap.resize( size, 0xFFFF ); // Not Maped values = 0xFFFF -> don't exist
+    mcu->createSignalTables( size );
 }
 
 void McuCreator::createRomMem( uint32_t size )
@@ -15,15 +15,13 @@ DataSpace::DataSpace()
     m_ramSize   = 0;
     m_regStart = 0xFFFF;
     m_regEnd   = 0;
+    m_sigAccess = false;
 }
 
 DataSpace::~DataSpace()
 {
-    for( uint16_t addr : m_readSignals.keys() )
-        delete m_readSignals.value( addr );
-
-    for( uint16_t addr : m_writeSignals.keys() )
-        delete m_writeSignals.value( addr );
+    for( McuSignal* regSignal : m_readSignals )  delete regSignal;
+    for( McuSignal* regSignal : m_writeSignals ) delete regSignal;
 
     m_readSignals.clear();
     m_writeSignals.clear();
@@ -50,9 +48,10 @@ void DataSpace::initialize()
 uint8_t DataSpace::readReg( uint16_t addr )
 {
     uint8_t v = m_dataMem[addr];
-    McuSignal* regSignal = m_readSignals.value( addr );
-    if( regSignal )
+    if( m_readSigMap[addr>>3] & (1<<(addr & 7)) )
     {
+        McuSignal* regSignal = m_readSignals[addr];
+        m_sigAccess = true;
         m_regOverride = -1;
         regSignal->emitValue( v );
         if( m_regOverride >= 0 ) v = (uint8_t)m_regOverride; // Value overriden in callback
@@ -69,9 +68,10 @@ void DataSpace::writeReg( uint16_t addr, uint8_t v, bool masked )
         if( addr < m_regMask.size() ) mask = m_regMask[addr];
         if( mask != 0xFF && mask != 0x00 ) v = (m_dataMem[addr] & ~mask) | (v & mask);
     }
-    McuSignal* regSignal = m_writeSignals.value( addr );
-    if( regSignal )
+    if( m_writeSigMap[addr>>3] & (1<<(addr & 7)) )
     {
+        McuSignal* regSignal = m_writeSignals[addr];
+        m_sigAccess = true;
         m_regOverride = -1;
         regSignal->emitValue( v );
         if( m_regOverride >= 0 ) v = (uint8_t)m_regOverride; // Value overriden in callback
@@ -79,6 +79,44 @@ void DataSpace::writeReg( uint16_t addr, uint8_t v, bool masked )
     if( mask != 0x00 ) m_dataMem[addr] = v;
 }
 
+void DataSpace::createSignalTables( uint32_t size ) // One entry per Data space address
+{
+    m_readSignals.resize( size, NULL );
+    m_writeSignals.resize( size, NULL );
+    m_readSigMap.resize( (size+7)/8, 0 );
+    m_writeSigMap.resize( (size+7)/8, 0 );
+}
+
+void DataSpace::freezeSignals()
+{
+    size_t size = 0;
+    for( McuSignal* regSignal : m_writeSignals ) if( regSignal ) size += regSignal->slotCount();
+    for( McuSignal* regSignal : m_readSignals )  if( regSignal ) size += regSignal->slotCount();
+
+    m_sigSlots.resize( size );
+    McuSignal::slot_t* pool = m_sigSlots.data();
+
+    for( McuSignal* regSignal : m_writeSignals ) if( regSignal ) pool = regSignal->freeze( pool );
+    for( McuSignal* regSignal : m_readSignals )  if( regSignal ) pool = regSignal->freeze( pool );
+}
+
+McuSignal* DataSpace::regSignal( uint16_t addr, bool write )
+{
+    if( addr >= m_readSignals.size() ) createSignalTables( addr+1 );
+
+    std::vector<McuSignal*>& sigList = write ? m_writeSignals : m_readSignals;
+    std::vector<uint8_t>&    sigMap  = write ? m_writeSigMap  : m_readSigMap;
+
+    McuSignal* regSignal = sigList[addr];
+    if( !regSignal )
+    {
+        regSignal = new McuSignal;
+        sigList[addr] = regSignal;
+        sigMap[addr>>3] |= 1<<(addr & 7);
+    }
+    return regSignal;
+}
+
 uint16_t DataSpace::getRegAddress( QString reg )// Get Reg address by name
 {
     uint16_t addr = 65535;
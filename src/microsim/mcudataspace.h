@@ -34,13 +34,22 @@ class DataSpace
         uint8_t  readReg( uint16_t addr );         // Read Register (call watchers)
         void     writeReg(uint16_t addr, uint8_t v, bool masked=true);// Write Register (call watchers)
 
+        // Register can be accessed directly: no watchers (and no write mask)
+        bool plainRead( uint16_t addr ) { return !(m_readSigMap[addr>>3] & (1<<(addr & 7))); }
+        bool plainWrite( uint16_t addr )
+        {
+            if( m_writeSigMap[addr>>3] & (1<<(addr & 7)) ) return false;
+            return addr >= m_regMask.size() || m_regMask[addr] == 0xFF;
+        }
+
         RamTable* getRamTable() { return m_ramTable; }
 
         QHash<QString, uint8_t>*       bitMasks() { return &m_bitMasks; }
         QHash<QString, uint16_t>*      bitRegs() { return &m_bitRegs; }
         QHash<QString, regInfo_t>*     regInfo()  { return &m_regInfo; }
-        QHash<uint16_t, McuSignal*>* readSignals() { return &m_readSignals; }
-        QHash<uint16_t, McuSignal*>* writeSignals() { return &m_writeSignals; }
+        McuSignal* regSignal( uint16_t addr, bool write ); // Get Register Signal, create if not exist
+        void createSignalTables( uint32_t size );
+        void freezeSignals();                      // Pack all Signal slots contiguously
 
         void setStatusBits( QStringList bits ) { m_statusBits = bits; }
         QStringList getStatusBits() { return m_statusBits; }
@@ -54,14 +63,18 @@ class DataSpace
         uint16_t m_regEnd;                         // Last  address of SFR Section
 
         bool m_isCpuRead;
+        bool m_sigAccess;                          // A Register with Signals was accessed
         uint32_t m_ramSize;
         std::vector<uint8_t>  m_dataMem;           // Whole Ram space including Registers
         std::vector<uint16_t> m_addrMap;           // Maps addresses in Data space
         std::vector<uint8_t>  m_regMask;           // Registers Write mask
 
         QHash<QString, regInfo_t>   m_regInfo;     // Access Reg Info by  Reg name
-        QHash<uint16_t, McuSignal*> m_readSignals; // Access read Reg Signals by Reg address
-        QHash<uint16_t, McuSignal*> m_writeSignals;// Access write Reg Signals by Reg address
+        std::vector<McuSignal*> m_readSignals;     // Access read Reg Signals by Reg address
+        std::vector<McuSignal*> m_writeSignals;    // Access write Reg Signals by Reg address
+        std::vector<uint8_t>    m_readSigMap;      // Bitmap: Reg address has read Signal
+        std::vector<uint8_t>    m_writeSigMap;     // Bitmap: Reg address has write Signal
+        std::vector<McuSignal::slot_t> m_sigSlots; // Frozen slots of all Signals
         QHash<QString, uint8_t>     m_bitMasks;    // Access Bit mask by bit name
         QHash<QString, uint16_t>    m_bitRegs;     // Access Reg. address by bit name
 
@@ -7,108 +7,115 @@
 #define MCUSIGNAL_H
 
 #include <vector>
+#include <cstring>
 #include <inttypes.h>
 
-class CallBackBase
+class McuSignal
 {
-        friend class McuSignal;
-
     public:
-        CallBackBase(){;}
-        virtual ~CallBackBase(){;}
+        class SlotClass;                      // Incomplete: largest member pointer size
+        typedef void (SlotClass::*slotFunc_t)(uint8_t);
 
-        virtual void call( uint8_t ){;}
-
-        CallBackBase* nextCallBack;
+        struct slot_t
+        {
+            void*   object;
+            void  (*thunk)( void*, const char*, uint8_t ); // Calls func on object
+            uint8_t mask;
+            alignas(slotFunc_t) char func[sizeof(slotFunc_t)]; // Member function pointer
+        };
 
     private:
-        uint8_t m_mask;
-};
-
-template <class Obj>
-class CallBack : public CallBackBase
-{
-        friend class McuSignal;
-
-    public:
-        CallBack( Obj* object, void (Obj::*func)(uint8_t) )
-        : CallBackBase()
+        template <class Obj>
+        static void callSlot( void* object, const char* func, uint8_t val )
         {
-            m_object = object;
-            m_func = func;
-            nextCallBack = nullptr;
+            void (Obj::*f)(uint8_t);
+            memcpy( &f, func, sizeof(f) );
+            (static_cast<Obj*>(object)->*f)( val );
         }
-        ~CallBack() {;}
 
-        virtual void call( uint8_t val ) override
-        { (m_object->*m_func)(val); }
-
-    private:
-        Obj* m_object;
-        void (Obj::*m_func)(uint8_t);
-};
+        template <class Obj>
+        static void setSlot( slot_t* slot, Obj* obj, void (Obj::*func)(uint8_t) )
+        {
+            static_assert( sizeof(func) <= sizeof(slotFunc_t), "McuSignal: member pointer too big" );
+            slot->object = obj;
+            slot->thunk  = &callSlot<Obj>;
+            memset( slot->func, 0, sizeof(slot->func) );
+            memcpy( slot->func, &func, sizeof(func) );
+        }
 
-class McuSignal
-{
     public:
         McuSignal()
         {
-            m_slot = nullptr;
+            m_first = nullptr;
+            m_end   = nullptr;
         }
-        ~McuSignal()
-        {
-            CallBackBase* slot = m_slot;
-            while( slot ) // delete slots
-            {
-                CallBackBase* slotDel = slot;
-                slot = slot->nextCallBack;
-                delete slotDel;
-        }   }
+        ~McuSignal(){;}
 
         template <class Obj>
         void connect( Obj* obj, void (Obj::*func)(uint8_t), uint8_t mask=0xFF )
         {
-            CallBack<Obj>* slot = new CallBack<Obj>( obj, func );
-            slot->m_mask = mask;
+            slot_t slot;
+            setSlot( &slot, obj, func );
+            slot.mask = mask;
 
-            // New slots are prepended (LIFO)
+            // New slots are called first (LIFO)
             // This means Interrupt flag clearing after register write callback
             // Because Interrupts are created first
-            slot->nextCallBack = m_slot;
-            m_slot = slot;
+            m_slots.push_back( slot );
+            unfreeze();
         }
 
         template <class Obj>
         void disconnect( Obj* obj, void (Obj::*func)(uint8_t) )
         {
-            CallBackBase* preSlot = 0;
-            CallBackBase* posSlot = m_slot;
-            while( posSlot )
+            slot_t slot;
+            setSlot( &slot, obj, func );
+
+            for( size_t i=0; i<m_slots.size(); ++i )
             {
-                CallBack<Obj>* cb = dynamic_cast<CallBack<Obj>*>(posSlot);
-
-                if( (cb->m_object == obj) && (cb->m_func == func))
-                {
-                    if( preSlot ) preSlot->nextCallBack = posSlot->nextCallBack;
-                    else          m_slot = posSlot->nextCallBack;
-                    delete posSlot;
-                    break;
-                }
-                preSlot = posSlot;
-                posSlot = posSlot->nextCallBack;
-        }   }
+                if( m_slots[i].object != slot.object ) continue;
+                if( m_slots[i].thunk  != slot.thunk  ) continue;
+                if( memcmp( m_slots[i].func, slot.func, sizeof(slot.func) ) ) continue;
+
+                m_slots.erase( m_slots.begin()+i );
+                break;
+            }
+            unfreeze();
+        }
 
         void emitValue( uint8_t val ) // Calls all connected functions with masked val.
         {
-            CallBackBase* slot = m_slot;
-            while( slot )
+            const slot_t* slot = m_end;
+            while( slot != m_first )
             {
-                slot->call( val & slot->m_mask );
-                slot = slot->nextCallBack;
+                --slot;
+                slot->thunk( slot->object, slot->func, val & slot->mask );
         }   }
 
+        size_t slotCount() { return m_slots.size(); }
+
+        // Copy slots to external contiguous storage with room for slotCount() slots.
+        // Storage must be kept unchanged while this Signal exists, returns end of copied slots.
+        slot_t* freeze( slot_t* pool )
+        {
+            if( m_slots.empty() ) return pool;
+            memcpy( pool, m_slots.data(), m_slots.size()*sizeof(slot_t) );
+            m_first = pool;
+            m_end   = pool+m_slots.size();
+            return (slot_t*)m_end;
+        }
+
     private:
-        CallBackBase* m_slot;
+        void unfreeze() // Use own slot list (changed after freeze)
+        {
+            m_first = m_slots.data();
+            m_end   = m_first+m_slots.size();
+        }
+
+        const slot_t* m_first;            // First slot in emit list
+        const slot_t* m_end;              // Past last slot (last slot is called first)
+
+        std::vector<slot_t> m_slots;      // Slots in connection order
 };
 
 #endif
@@ -17,24 +17,8 @@ void watchRegister( uint16_t addr, int write
 {
     if( addr == 0 ) qDebug() << "Warning: watchRegister address 0 ";
 
-    if( write )
-    {
-        McuSignal* regSignal = mcu->writeSignals()->value( addr );
-        if( !regSignal )
-        {
-            regSignal = new McuSignal;
-            mcu->writeSignals()->insert( addr, regSignal );
-        }
-        regSignal->connect( inst, func, mask );
-    }else{
-        McuSignal* regSignal = mcu->readSignals()->value( addr );
-        if( !regSignal )
-        {
-            regSignal = new McuSignal;
-            mcu->readSignals()->insert( addr, regSignal );
-        }
-        regSignal->connect( inst, func, mask  );
-    }
+    McuSignal* regSignal = mcu->regSignal( addr, write );
+    regSignal->connect( inst, func, mask );
 }
 
 template <class T>                // Add callback for Register changes by names
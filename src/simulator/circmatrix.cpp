@@ -4,7 +4,11 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <iostream>
+#include <algorithm>
+#include <set>
+#include <stdint.h>
 #include <QtMath>
+#include <qtconcurrentmap.h>
 //#include <iomanip> // setw()
 
 #include "circmatrix.h"
@@ -16,19 +20,29 @@ CircMatrix::CircMatrix()
 {
     m_pSelf = this;
     m_numEnodes = 0;
+    m_sparse    = false;
+    m_sparseMin = 32;
+    m_lowRank    = false;
+    m_lowRankMin = 16;
+    m_maxRank    = 2;
+    m_maxUpdates = 64;
+    m_parallel    = false;
+    m_parallelMin = 64;
+}
+CircMatrix::~CircMatrix()
+{
+    clearGroups();
 }
-CircMatrix::~CircMatrix(){}
 
 void CircMatrix::createMatrix( QList<eNode*> &eNodeList )
 {
     m_eNodeList = &eNodeList;
     m_numEnodes = eNodeList.size();
 
-    m_circMatrix.clear();
-    m_coefVect.clear();
-
-    m_circMatrix.resize( m_numEnodes , d_vector_t( m_numEnodes , 0 ) );
-    m_coefVect.resize( m_numEnodes , 0 );
+    m_rowChanged.assign( m_numEnodes , false );
+    m_nodeLocal.assign( m_numEnodes , 0 );
+    m_nodeGroup.assign( m_numEnodes , -1 );
+    m_diagonal.assign(  m_numEnodes , &m_dummy );
 
     /// qDebug() <<"\n  Initializing Matrix: "<< m_numEnodes << " eNodes";
     analyze();
@@ -51,15 +65,37 @@ void CircMatrix::addConnections( int enodNum, QList<int>* nodeGroup, QList<int>*
     }
 }
 
+double* CircMatrix::getEntry( int row, int col ) // Admitance at row, col (eNode indexes)
+{
+    int group = m_nodeGroup[row];
+    if( group < 0 || m_nodeGroup[col] != group ) return &m_dummy; // Not in any group
+
+    int r = m_nodeLocal[row];
+    int c = m_nodeLocal[col];
+
+    sparse_t* sp = m_sparseList[group];
+    if( !sp ){
+        dense_t* de = m_denseList[group];
+        return &(de->a[ r*de->ld+c ]);
+    }
+    int k = sp->iperm[c];
+    const int* first = sp->colIndex.data()+sp->rowStart[ sp->iperm[r] ];
+    const int* last  = sp->colIndex.data()+sp->rowStart[ sp->iperm[r]+1 ];
+    const int* pos = std::lower_bound( first, last, k ); // Columns are sorted in each row
+    if( pos == last || *pos != k ) return &m_dummy;
+
+    return &(sp->a[ pos-sp->colIndex.data() ]);
+}
+
 void CircMatrix::analyze()
 {
     QList<int> allNodes;
     for( int i=0; i<m_numEnodes; i++ ) allNodes.append( i+1 );
 
-    m_aList.clear();
-    m_aFaList.clear();
     m_bList.clear();
+    m_xList.clear();
     m_eNodeActList.clear();
+    clearGroups();
     int group = 0;
     int singleNode = 0;
 
@@ -75,41 +111,61 @@ void CircMatrix::analyze()
             enod->setSingle( true );
             singleNode++;
         }else{
-            dp_matrix_t a;
-            d_matrix_t ap;
-            dp_vector_t b;
             QList<eNode*> eNodeActive;
+            std::sort( nodeGroup.begin(), nodeGroup.end() );
 
-            a.resize( numEnodes , dp_vector_t( numEnodes , 0 ) );
-            ap.resize( numEnodes , d_vector_t( numEnodes , 0 ) );
-            b.resize( numEnodes , 0 );
-
-            int ny=0;
-            for( int y=0; y<m_numEnodes; ++y )    // Copy data to reduced Matrix
+            for( int ny=0; ny<numEnodes; ++ny ) // Local index in eNode number order
             {
-                if( !nodeGroup.contains( y+1 ) ) continue;
-                int nx=0;
-                for( int x=0; x<m_numEnodes; ++x )
-                {
-                    if( !nodeGroup.contains( x+1 ) ) continue;
-                    a[nx][ny] = &(m_circMatrix[x][y]);
-                    nx++;
-                }
-                b[ny] = &(m_coefVect[y]);
+                int y = nodeGroup.at( ny )-1;
+                m_nodeLocal[y] = ny;
+                m_nodeGroup[y] = group;
                 eNode* node = m_eNodeList->at(y);
                 node->setNodeGroup( group );
                 eNodeActive.append( node );
-                ny++;
             }
-            m_aList.append( a );
-            m_aFaList.append( ap );
-            m_bList.append( b );
+            bool sparse = m_sparse && (numEnodes >= m_sparseMin);
+
+            sparse_t* sp = NULL;
+            dense_t*  de = NULL;
+            if( sparse ){ // Sparse groups don't need dense matrices
+                sp = new sparse_t;
+                analyzeSparse( sp, eNodeActive );
+            }else{
+                de = new dense_t;
+                de->ld = (numEnodes+3) & ~3; // Rows aligned to 32 bytes
+                int size = numEnodes*de->ld;
+                de->store.assign( 2*size+4, 0 );
+                uintptr_t addr = ((uintptr_t)de->store.data()+31) & ~(uintptr_t)31;
+                de->a  = (double*)addr;
+                de->lu = de->a+size;
+            }
+            for( int ny=0; ny<numEnodes; ++ny )
+            {
+                int y = nodeGroup.at( ny )-1;
+                if( sp ) m_diagonal[y] = &(sp->a[ sp->diagPos[ sp->iperm[ny] ] ]);
+                else     m_diagonal[y] = &(de->a[ ny*de->ld+ny ]);
+            }
+            m_sparseList.push_back( sp );
+            m_denseList.push_back( de );
+
+            update_t* up = NULL;
+            if( m_lowRank && (numEnodes >= m_lowRankMin) ){
+                up = new update_t;
+                up->a0.resize( sp ? sp->a.size() : numEnodes*de->ld, 0 );
+                up->updates = 0;
+            }
+            m_updateList.push_back( up );
+            m_bList.push_back( d_vector_t( numEnodes, 0 ) );
+            m_xList.push_back( d_vector_t( numEnodes, 0 ) );
             m_eNodeActList.append( eNodeActive );
             group++;
         }
     }
     m_admitChanged.resize( group, true );
     m_currChanged.resize(  group, true );
+    m_changedRows.assign(  group, std::vector<int>() );
+    m_solveOk.assign( group, 1 );
+    m_solveList.reserve( group );
 
     /// qDebug() <<"CircMatrix::solveMatrix"<<group<<"Circuits";
     /// qDebug() <<"CircMatrix::solveMatrix"<<singleNode<<"Single Nodes\n";
@@ -117,111 +173,433 @@ void CircMatrix::analyze()
 
 bool CircMatrix::solveMatrix()
 {
-    bool ok = true;
-    for( int i=0; i<m_bList.size(); ++i )
+    m_solveList.clear();
+    int size = 0;
+    for( uint i=0; i<m_bList.size(); ++i )
     {
         if( !m_admitChanged[i] && !m_currChanged[i] ) continue;
+        m_solveList.push_back( i );
+        size += m_xList[i].size();
+    }
+    // Groups don't share any data until voltages are set, so results
+    // are the same whichever thread solves each group.
+    if( m_parallel && m_solveList.size() > 1 && size >= m_parallelMin )
+        QtConcurrent::blockingMap( m_solveList, [this]( int group ){ solveGroup( group ); } );
+    else
+        for( int group : m_solveList ) solveGroup( group );
 
-        m_eNodeActive = &(m_eNodeActList[i]);
-        int n = m_eNodeActive->size();
+    bool ok = true;
+    for( int i : m_solveList ) // Set Node Voltages, always in the same order
+    {
+        const d_vector_t& x = m_xList[i];
+        QList<eNode*>& nodes = m_eNodeActList[i];
+        for( int j=x.size()-1; j>=0; --j ) nodes.at(j)->setVolt( x[j] );
 
-        if( m_admitChanged[i] ) factorMatrix( n, i );
-        if( !luSolve( n, i ) ) ok = false;
+        for( int row : m_changedRows[i] ) m_rowChanged[row] = false;
+        m_changedRows[i].clear();
 
+        if( !m_solveOk[i] ) ok = false;
         m_currChanged[i]  = false;
         m_admitChanged[i] = false;
     }
     return ok;
 }
 
+void CircMatrix::solveGroup( int group ) // Can run in any thread
+{
+    int n = m_xList[group].size();
+
+    if( m_admitChanged[group] )
+    {
+        if( !m_updateList[group] || !lowRankUpdate( n, group ) ) factorGroup( n, group );
+    }
+    m_solveOk[group] = luSolve( n, group, m_xList[group] );
+}
+
+void CircMatrix::factorGroup( int n, int group )
+{
+    sparse_t* sp = m_sparseList[group];
+    if( sp ) factorSparse( sp );
+    else     factorMatrix( n, group );
+
+    update_t* up = m_updateList[group];
+    if( !up ) return;
+
+    if( sp ) up->a0 = sp->a;  // Save admitances of this factorization
+    else{
+        dense_t* de = m_denseList[group];
+        std::copy( de->a, de->a+n*de->ld, up->a0.begin() );
+    }
+    up->rows.clear();
+    up->d.clear();
+    up->z.clear();
+    up->updates = 0;
+}
+
 void CircMatrix::factorMatrix( int n, int group ) // Factor matrix into Lower/Upper triangular
 {
-    dp_matrix_t& ap = m_aList[group];
-    d_matrix_t&   a = m_aFaList[group];
+    dense_t* de = m_denseList[group];
+    const int ld = de->ld;
+    std::copy( de->a, de->a+n*ld, de->lu );
 
     /*std::cout << "\nAdmitance Matrix:\n"<< std::endl;
     for( int i=0; i<n; i++ )
     {
-        for( int j=0; j<n; ++j ) { std::cout << std::setw(15); std::cout << *ap[i][j]; }
+        for( int j=0; j<n; ++j ) { std::cout << std::setw(15); std::cout << de->a[i*ld+j]; }
         std::cout << std::endl;
     }*/
 
-    int row,col,k;
-
-    for( col=0; col<n; ++col )              // Crout's method: loop through columns
+    for( int row=1; row<n; ++row )        // Row by row, inner loops run on contiguous rows
     {
-        for( row=0; row<col; ++row )        // Upper triangular elements
+        double* w = de->lu+row*ld;
+        for( int k=0; k<row; ++k )        // Lower triangular elements
         {
-            double q = *(ap[row][col]);
-            for( k=0; k<row; ++k ) q -= a[row][k]*a[k][col];
-            a[row][col] = q;
-        }
-        for( row=col; row<n; ++row )        // Lower triangular elements
-        {
-            double q = *(ap[row][col]);
-            for( k=0; k<col; ++k ) q -= a[row][k]*a[k][col];
-            a[row][col] = q;
-        }
-        if( col != n-1 )                    // Normalize column respect to diagonal
-        {
-            double div = a[col][col];
-            if( div == 0 ) continue;
-            for( row=col+1; row<n; ++row ) a[row][col] /= div;
+            const double* u = de->lu+k*ld;
+            double l = w[k];
+            double div = u[k];
+            if( div != 0 ) l /= div;
+            w[k] = l;
+            if( l == 0 ) continue;
+            for( int col=k+1; col<n; ++col ) w[col] -= l*u[col]; // Upper triangular elements
         }
     }
     /*std::cout << "\nFactored Matrix:\n" << std::endl;
     for( int i=0; i<n; i++ )
     {
-        for( int j=0; j<n; j++ ) { std::cout << std::setw(15); std::cout << a[i][j]; }
+        for( int j=0; j<n; j++ ) { std::cout << std::setw(15); std::cout << de->lu[i*ld+j]; }
         std::cout << std::endl;
     }*/
 }
 
-bool CircMatrix::luSolve( int n, int group ) // Solves the system to get voltages for each node
+bool CircMatrix::luSolve( int n, int group, d_vector_t &b ) // Solves the system to get voltages for each node
+{
+    b = m_bList[group];
+
+    bool isOk = substitute( n, group, b );
+
+    update_t* up = m_updateList[group];
+    if( up && !up->rows.empty() ) // Woodbury: x = y - Z*(I+D*Z)^-1*D*y
+    {
+        int k = up->rows.size();
+        d_vector_t& w = up->w;
+        for( int r=0; r<k; ++r ){
+            const d_vector_t& d = up->d[r];
+            double tot = 0;
+            for( int j=0; j<n; ++j ) tot += d[j]*b[j];
+            w[r] = tot;
+        }
+        for( int r=0; r<k; ++r ){
+            double t = 0;
+            for( int c=0; c<k; ++c ) t += up->sInv[r][c]*w[c];
+            if( t == 0 ) continue;
+            const d_vector_t& z = up->z[r];
+            for( int j=0; j<n; ++j ) b[j] -= t*z[j];
+        }
+    }
+    return isOk;
+}
+
+bool CircMatrix::substitute( int n, int group, d_vector_t &b ) // b = A^-1 * b
 {
-    const d_matrix_t&  a  = m_aFaList[group];
-    const dp_vector_t& bp = m_bList[group];
+    sparse_t* sp = m_sparseList[group];
+    if( sp ) return substSparse( sp, b );
+
+    const dense_t* de = m_denseList[group];
+    const int ld = de->ld;
 
     /*std::cout << "\nCurrent vector:\n" << std::endl;
     for( int i=0; i<n; i++ )
     {
-        std::cout << std::setw(15); std::cout << *bp[i];
+        std::cout << std::setw(15); std::cout << b[i];
         std::cout << std::endl;
     }*/
 
-    d_vector_t b;
-    b.resize( n , 0 );
-
     double tot;
     int i;
-    for( i=0; i<n; ++i )
-    {
-        tot = *(bp[i]);
-        b[i] = tot;
-        if( tot != 0 ) break; // First nonzero b element
-    }
+    for( i=0; i<n; ++i ) if( b[i] != 0 ) break; // First nonzero b element
 
     int bi = i++;
     for( ; i<n; ++i )
     {
-        tot = *(bp[i]);
-        for( int j=bi; j<i; ++j ) tot -= a[i][j]*b[j]; // Forward substitution from lower triangular matrix
+        const double* a = de->lu+i*ld;
+        tot = b[i];
+        for( int j=bi; j<i; ++j ) tot -= a[j]*b[j]; // Forward substitution from lower triangular matrix
         b[i] = tot;
     }
     bool isOk = true;
 
     for( i=n-1; i>=0; --i )
     {
+        const double* a = de->lu+i*ld;
         tot = b[i];
-        for( int j=i+1; j<n; ++j ) tot -= a[i][j]*b[j]; // Back substitution from upper triangular matrix
+        for( int j=i+1; j<n; ++j ) tot -= a[j]*b[j]; // Back substitution from upper triangular matrix
 
-        double div = a[i][i];
+        double div = a[i];
         double volt = 0;
         if( div != 0 ) volt = tot/div;
         else isOk = false;
 
         b[i] = volt;
-        m_eNodeActive->at(i)->setVolt( volt );         // Set Node Voltages
     }
     return isOk;
 }
+
+// Low rank update: if only a few rows changed since last factorization,
+// A = A0 + U*D  (U: unit columns of changed rows, D: row deltas)
+// solve with Woodbury formula and factors of A0 instead of refactoring.
+bool CircMatrix::lowRankUpdate( int n, int group )
+{
+    update_t* up = m_updateList[group];
+    if( up->updates >= m_maxUpdates ) return false; // Refactor to bound numerical error
+
+    for( int row : m_changedRows[group] )           // Add new changed rows
+    {
+        int r = m_nodeLocal[row];
+        if( std::find( up->rows.begin(), up->rows.end(), r ) != up->rows.end() ) continue;
+        if( up->rows.size() >= m_maxRank ) return false;
+
+        d_vector_t z( n, 0 );                       // z = A0^-1 * e_r
+        z[r] = 1;
+        substitute( n, group, z );
+        up->rows.push_back( r );
+        up->z.push_back( z );
+    }
+    int k = 0;
+    up->d.resize( up->rows.size() );
+    for( uint i=0; i<up->rows.size(); ++i )         // Get row deltas, drop rows back to A0
+    {
+        if( !rowDelta( n, group, up->rows[i], up->d[k] ) ) continue;
+        if( (int)i != k ){
+            up->rows[k] = up->rows[i];
+            up->z[k].swap( up->z[i] );
+        }
+        k++;
+    }
+    up->rows.resize( k );
+    up->z.resize( k );
+    up->d.resize( k );
+    up->w.resize( k );
+    up->updates++;
+    if( k == 0 ) return true;
+
+    d_matrix_t s( k, d_vector_t( 2*k, 0 ) );       // [ I+D*Z | I ]
+    for( int r=0; r<k; ++r )
+    {
+        for( int c=0; c<k; ++c )
+        {
+            double tot = (r == c) ? 1 : 0;
+            const d_vector_t& d = up->d[r];
+            const d_vector_t& z = up->z[c];
+            for( int j=0; j<n; ++j ) tot += d[j]*z[j];
+            s[r][c] = tot;
+        }
+        s[r][k+r] = 1;
+    }
+    for( int c=0; c<k; ++c )                        // Gauss-Jordan inversion
+    {
+        int piv = c;
+        for( int r=c+1; r<k; ++r ) if( qFabs( s[r][c] ) > qFabs( s[piv][c] ) ) piv = r;
+        if( qFabs( s[piv][c] ) < 1e-9 ) return false; // Near singular: refactor
+        s[c].swap( s[piv] );
+
+        double div = s[c][c];
+        for( int j=0; j<2*k; ++j ) s[c][j] /= div;
+        for( int r=0; r<k; ++r )
+        {
+            if( r == c ) continue;
+            double f = s[r][c];
+            if( f == 0 ) continue;
+            for( int j=0; j<2*k; ++j ) s[r][j] -= f*s[c][j];
+        }
+    }
+    up->sInv.assign( k, d_vector_t( k, 0 ) );
+    for( int r=0; r<k; ++r )
+        for( int c=0; c<k; ++c ) up->sInv[r][c] = s[r][k+c];
+
+    return true;
+}
+
+bool CircMatrix::rowDelta( int n, int group, int row, d_vector_t &d ) // Row change since last factorization
+{
+    update_t* up = m_updateList[group];
+    sparse_t* sp = m_sparseList[group];
+    d.assign( n, 0 );
+    bool changed = false;
+
+    if( sp ){
+        int k = sp->iperm[row];
+        for( int p=sp->rowStart[k]; p<sp->rowStart[k+1]; ++p )
+        {
+            double delta = sp->a[p] - up->a0[p];
+            if( delta == 0 ) continue;
+            d[ sp->perm[sp->colIndex[p]] ] = delta;
+            changed = true;
+        }
+    }else{
+        dense_t* de = m_denseList[group];
+        const double* a  = de->a+row*de->ld;
+        const double* a0 = &(up->a0[row*de->ld]);
+        for( int col=0; col<n; ++col )
+        {
+            double delta = a[col] - a0[col];
+            if( delta == 0 ) continue;
+            d[col] = delta;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void CircMatrix::clearGroups()
+{
+    for( sparse_t* sp : m_sparseList ) delete sp;
+    m_sparseList.clear();
+
+    for( dense_t* de : m_denseList ) delete de;
+    m_denseList.clear();
+
+    for( update_t* up : m_updateList ) delete up;
+    m_updateList.clear();
+}
+
+// Symbolic analysis, done once per group at analyze():
+// Get elimination order by Minimum Degree on the node graph,
+// and the filled pattern of L+U for that order.
+// Numeric factorizations reuse this pattern.
+void CircMatrix::analyzeSparse( sparse_t* sp, QList<eNode*> &nodes )
+{
+    int n = nodes.size();
+
+    std::vector<int> local( m_numEnodes+1, -1 ); // eNode number to local index
+    for( int i=0; i<n; ++i ) local[ nodes.at(i)->getNodeNumber() ] = i;
+
+    std::vector<std::set<int>> graph( n );       // Symmetric node graph
+    for( int i=0; i<n; ++i )
+    {
+        for( int nodeNum : nodes.at(i)->getConnections() )
+        {
+            if( nodeNum <= 0 ) continue;
+            int j = local[nodeNum];
+            if( j < 0 || j == i ) continue;
+            graph[i].insert( j );
+            graph[j].insert( i );
+        }
+    }
+    std::vector<std::vector<int>> filled( n ); // Filled graph adjacency
+    std::vector<bool> done( n, false );
+    sp->perm.clear();
+
+    for( int k=0; k<n; ++k )  // Minimum Degree ordering, eliminating nodes adds fill-in
+    {
+        int v = -1;
+        size_t minDeg = 0;
+        for( int i=0; i<n; ++i )
+        {
+            if( done[i] ) continue;
+            if( v < 0 || graph[i].size() < minDeg ){ v = i; minDeg = graph[i].size(); }
+        }
+        done[v] = true;
+        sp->perm.push_back( v );
+
+        std::set<int>& adj = graph[v];
+        for( int u : adj )
+        {
+            graph[u].erase( v );
+            for( int w : adj ) if( w != u ) graph[u].insert( w ); // Fill-in
+            filled[v].push_back( u );
+            filled[u].push_back( v );
+        }
+        adj.clear();
+    }
+    sp->iperm.assign( n, 0 );
+    for( int k=0; k<n; ++k ) sp->iperm[ sp->perm[k] ] = k;
+
+    sp->rowStart.assign( n+1, 0 );
+    sp->diagPos.assign( n, 0 );
+    sp->colIndex.clear();
+    sp->a.clear();
+
+    for( int k=0; k<n; ++k )        // Create CSR pattern in elimination order
+    {
+        int i = sp->perm[k];
+        std::vector<int> cols;
+        cols.push_back( k );
+        for( int j : filled[i] ) cols.push_back( sp->iperm[j] );
+        std::sort( cols.begin(), cols.end() );
+
+        sp->rowStart[k] = sp->colIndex.size();
+        for( int c : cols )
+        {
+            if( c == k ) sp->diagPos[k] = sp->colIndex.size();
+            sp->colIndex.push_back( c );
+        }
+    }
+    sp->rowStart[n] = sp->colIndex.size();
+    sp->a.assign(  sp->colIndex.size(), 0 );
+    sp->lu.assign( sp->colIndex.size(), 0 );
+    sp->work.assign( n, 0 );
+}
+
+void CircMatrix::factorSparse( sparse_t* sp ) // Numeric factorization, row by row
+{
+    int n = sp->perm.size();
+    const int* rowStart = sp->rowStart.data();
+    const int* colIndex = sp->colIndex.data();
+    const int* diagPos  = sp->diagPos.data();
+    double* lu = sp->lu.data();
+    double* w  = sp->work.data();
+
+    for( int i=0; i<n; ++i )
+    {
+        int start = rowStart[i];
+        int end   = rowStart[i+1];
+        int diag  = diagPos[i];
+
+        for( int p=start; p<end; ++p ) w[colIndex[p]] = sp->a[p]; // Scatter row
+
+        for( int p=start; p<diag; ++p )    // Lower triangular elements
+        {
+            int k = colIndex[p];
+            double l = w[k];
+            double div = lu[diagPos[k]];
+            if( div != 0 ) l /= div;
+            w[k] = l;
+            if( l == 0 ) continue;
+            for( int q=diagPos[k]+1; q<rowStart[k+1]; ++q ) w[colIndex[q]] -= l*lu[q];
+        }
+        for( int p=start; p<end; ++p ) lu[p] = w[colIndex[p]]; // Gather row
+    }
+}
+
+bool CircMatrix::substSparse( sparse_t* sp, d_vector_t &b )
+{
+    int n = sp->perm.size();
+    const int* rowStart = sp->rowStart.data();
+    const int* colIndex = sp->colIndex.data();
+    const int* diagPos  = sp->diagPos.data();
+    const double* lu = sp->lu.data();
+    double* y = sp->work.data();
+
+    for( int i=0; i<n; ++i )            // Forward substitution from lower triangular matrix
+    {
+        double tot = b[sp->perm[i]];
+        for( int p=rowStart[i]; p<diagPos[i]; ++p ) tot -= lu[p]*y[colIndex[p]];
+        y[i] = tot;
+    }
+    bool isOk = true;
+
+    for( int i=n-1; i>=0; --i )         // Back substitution from upper triangular matrix
+    {
+        double tot = y[i];
+        for( int p=diagPos[i]+1; p<rowStart[i+1]; ++p ) tot -= lu[p]*y[colIndex[p]];
+
+        double div = lu[diagPos[i]];
+        double volt = 0;
+        if( div != 0 ) volt = tot/div;
+        else isOk = false;
+        y[i] = volt;
+    }
+    for( int i=0; i<n; ++i ) b[sp->perm[i]] = y[i];
+
+    return isOk;
+}
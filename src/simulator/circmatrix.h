@@ -14,9 +14,38 @@
 class CircMatrix
 {
     typedef std::vector<double>      d_vector_t;
-    typedef std::vector<double*>     dp_vector_t;
     typedef std::vector<d_vector_t>  d_matrix_t;
-    typedef std::vector<dp_vector_t> dp_matrix_t;
+
+    struct dense_t          // Dense LU data for one group
+    {
+        int        ld;              // Row length, padded to keep rows aligned
+        double*    a;               // Admitances, row major n*ld
+        double*    lu;              // L (unit diagonal, not stored) and U values
+        d_vector_t store;           // Storage for a and lu
+    };
+
+    struct sparse_t         // Sparse LU data for one group
+    {
+        std::vector<int> perm;      // Elimination order: perm[k] = local node index
+        std::vector<int> iperm;     // Inverse of perm
+        std::vector<int> rowStart;  // Filled pattern in CSR, rows/cols in elimination order
+        std::vector<int> colIndex;
+        std::vector<int> diagPos;   // Position of diagonal element in each row
+        d_vector_t       a;         // Admitance for each pattern position
+        d_vector_t       lu;        // L (unit diagonal, not stored) and U values
+        d_vector_t       work;
+    };
+
+    struct update_t         // Low rank updates against last factorization
+    {
+        d_vector_t       a0;        // Admitances at last factorization (dense or sparse pattern)
+        std::vector<int> rows;      // Local rows changed since last factorization
+        d_matrix_t       d;         // Row deltas:  A = A0 + sum( e_row * d_row )
+        d_matrix_t       z;         // A0^-1 * e_row
+        d_matrix_t       sInv;      // ( I + D*Z )^-1
+        d_vector_t       w;
+        int              updates;   // Updates done since last factorization
+    };
 
     public:
         CircMatrix();
@@ -27,16 +56,29 @@ class CircMatrix
         void createMatrix( QList<eNode*> &eNodeList );
         bool solveMatrix();
 
+        bool sparse() { return m_sparse; }
+        void setSparse( bool s ) { m_sparse = s; }
+
+        bool lowRank() { return m_lowRank; }
+        void setLowRank( bool l ) { m_lowRank = l; }
+
+        bool parallel() { return m_parallel; }
+        void setParallel( bool p ) { m_parallel = p; }
+
         inline void stampDiagonal( int group, int n, double value ){
             m_admitChanged[group] = true;
-            m_circMatrix[n-1][n-1] = value;      // eNode numbers start at 1
+            *(m_diagonal[n-1]) = value;          // eNode numbers start at 1
+            if( !m_rowChanged[n-1] ){            // Row changes used by low rank updates
+                m_rowChanged[n-1] = true;
+                m_changedRows[group].push_back( n-1 );
+            }
         }
         inline void stampMatrix( int row, int col, double value ){
-            m_circMatrix[row-1][col-1] = value;      // eNode numbers start at 1
+            *(getEntry( row-1, col-1 )) = value;  // eNode numbers start at 1
         }
         inline void stampCoef( int group, int row, double value ){
             m_currChanged[group] = true;
-            m_coefVect[row-1] = value;
+            m_bList[group][ m_nodeLocal[row-1] ] = value;
         }
 
     private:
@@ -44,25 +86,54 @@ class CircMatrix
 
         void analyze();
         void addConnections( int enodNum, QList<int>* nodeGroup, QList<int>* allNodes );
+        double* getEntry( int row, int col );
 
+        void solveGroup( int group );
+        inline void factorGroup( int n, int group );
         inline void factorMatrix( int n, int group );
-        inline bool luSolve( int n, int group );
+        inline bool luSolve( int n, int group, d_vector_t &b );
+        inline bool substitute( int n, int group, d_vector_t &b );
+
+        void analyzeSparse( sparse_t* sp, QList<eNode*> &nodes );
+        inline void factorSparse( sparse_t* sp );
+        inline bool substSparse( sparse_t* sp, d_vector_t &b );
+        void clearGroups();
+
+        bool lowRankUpdate( int n, int group );
+        bool rowDelta( int n, int group, int row, d_vector_t &d );
 
         int m_numEnodes;
         QList<eNode*>* m_eNodeList;
 
-        QList<dp_matrix_t> m_aList;
-        QList<d_matrix_t>  m_aFaList;
-        QList<dp_vector_t> m_bList;
+        std::vector<d_vector_t> m_bList;      // Currents of each group
+
+        std::vector<dense_t*>  m_denseList;  // NULL for groups solved by sparse LU
+        std::vector<sparse_t*> m_sparseList; // NULL for groups solved by dense LU
+        bool m_sparse;
+        int  m_sparseMin;  // Minimum group size to use sparse LU
+
+        std::vector<update_t*> m_updateList; // NULL for groups always refactored
+        std::vector<std::vector<int>> m_changedRows; // Rows changed in each group since last solve
+        std::vector<bool> m_rowChanged;
+        std::vector<int>  m_nodeLocal;       // eNode index to index in group
+        std::vector<int>  m_nodeGroup;       // eNode index to group, -1 for single eNodes
+        std::vector<double*> m_diagonal;     // eNode index to diagonal admitance
+        double m_dummy;                      // Entry for stamps outside any group
+        bool m_lowRank;
+        int  m_lowRankMin; // Minimum group size to use low rank updates
+        uint m_maxRank;    // Maximum number of changed rows for low rank updates
+        int  m_maxUpdates; // Refactor after this number of updates to bound numerical error
+
+        bool m_parallel;
+        int  m_parallelMin;           // Minimum nodes in changed groups to solve in parallel
+        std::vector<int>  m_solveList;   // Changed groups to solve
+        std::vector<char> m_solveOk;     // Result of each group solve (written by worker threads)
+        std::vector<d_vector_t> m_xList; // Node voltages of each group
 
         std::vector<bool>    m_admitChanged;
         std::vector<bool>    m_currChanged;
-        QList<eNode*>*       m_eNodeActive;
         QList<QList<eNode*>> m_eNodeActList;
 
-        d_matrix_t m_circMatrix;
-        d_vector_t m_coefVect;
-
         //bool m_admitChanged;
         //bool m_currChanged;
 };
@@ -11,8 +11,9 @@ eElement::eElement( QString id )
 {
     m_elmId = id;
     nextChanged = NULL;
-    nextEvent  = NULL;
     eventTime = 0;
+    eventSeq  = 0;
+    eventIdx  = -1;
     m_pendingTime = 0;
     added = false;
     m_step = 0;
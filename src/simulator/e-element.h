@@ -40,8 +40,9 @@ class eElement
         eElement* nextChanged;
         bool added;
 
-        eElement* nextEvent;
         uint64_t eventTime;
+        uint64_t eventSeq; // Insertion order, breaks ties between same eventTime
+        int      eventIdx; // Position in Simulator event queue, -1 if not scheduled
 
     protected:
         uint64_t m_pendingTime;
@@ -6,6 +6,7 @@
 #include "e-node.h"
 #include "pin.h"
 #include "e-pin.h"
+#include "iopin.h"
 #include "connector.h"
 #include "e-element.h"
 #include "circmatrix.h"
@@ -16,12 +17,9 @@ eNode::eNode( QString id )
     m_id = id;
     m_nodeNum = 0;
 
-    m_voltChEl     = NULL;
-    m_nonLinEl     = NULL;
-    m_firstAdmit   = NULL;
-    m_firstSingAdm = NULL;
-    m_firstCurrent = NULL;
-    m_nodeAdmit    = NULL;
+    m_voltChEl = NULL;
+    m_nonLinEl = NULL;
+    m_logicPin = NULL;
 
     if( !id.isEmpty() ) Simulator::self()->addToEnodeList( this );
 }
@@ -29,10 +27,6 @@ eNode::~eNode()
 {
     clearElmList( m_voltChEl );
     clearElmList( m_nonLinEl );
-    clearConnList( m_firstAdmit );
-    clearConnList( m_firstSingAdm );
-    clearConnList( m_firstCurrent );
-    clearConnList( m_nodeAdmit );
 }
 
 void eNode::initialize()
@@ -46,6 +40,9 @@ void eNode::initialize()
     m_nodeGroup = -1;
     nextCH = NULL;
     m_volt = 0;
+    m_totalAdmit = 0;
+    m_totalCurr  = 0;
+    m_logicPin = NULL;
 
     clearElmList( m_voltChEl );
     m_voltChEl = NULL;
@@ -53,54 +50,70 @@ void eNode::initialize()
     clearElmList( m_nonLinEl );
     m_nonLinEl = NULL;
 
-    clearConnList( m_firstAdmit );
-    m_firstAdmit = NULL;
+    m_admit.clear();
+    m_singAdm.clear();
+    m_current.clear();
+    m_nodeAdmit.clear();
+    m_changedAdmit.clear();
+    m_admitSum.clear();
+    m_currSum.clear();
 
-    clearConnList( m_firstSingAdm );
-    m_firstSingAdm = NULL;
+    m_nodeList.clear();
+}
 
-    clearConnList( m_firstCurrent );
-    m_firstCurrent = NULL;
+// ePins keep the index of their Connection, so stamps don't walk the lists.
+// Index is checked because ePins can move to other eNodes.
+inline int eNode::findSlot( std::vector<Connection> &list, ePin* epin, int &slot )
+{
+    if( (uint)slot < list.size() && list[slot].epin == epin ) return slot;
 
-    clearConnList( m_nodeAdmit );
-    m_nodeAdmit = NULL;
+    for( int i=list.size()-1; i>=0; --i ) // Last added first
+        if( list[i].epin == epin ) return slot = i;
+    return -1;
+}
 
-    m_nodeList.clear();
+inline void eNode::addNodeAdmit( int slot, double delta )
+{
+    NodeAdmit& na = m_nodeAdmit[slot];
+    na.admit.add( delta );
+    if( na.changed ) return;
+    na.changed = true;
+    m_changedAdmit.push_back( slot );
 }
 
-void eNode::addConnection( ePin* epin, int node )
+int eNode::nodeSlot( int node ) // Create list of admitances to nodes
 {
-    if( node == m_nodeNum ) return;// Be sure msg doesn't come from this node
+    if( !m_nodeList.contains( node ) ) m_nodeList.append( node ); // Used by CircMatrix
+    if( node <= 0 ) return -1;
 
-    Connection* first = m_firstAdmit; // Create list of connections
-    while( first ){
-        if( first->epin == epin ) return; // Connection already in the list
-        first = first->next;
-    }
-    Connection* conn = new Connection( epin, node );
-    conn->next = m_firstAdmit;  // Prepend
-    m_firstAdmit = conn;
+    for( uint i=0; i<m_nodeAdmit.size(); ++i )
+        if( m_nodeAdmit[i].node == node ) return i; // Node already in the list
 
-    first = m_nodeAdmit;            // Create list of admitances to nodes (reusing Connection class)
-    while( first ){
-        if( first->node == node ) return; // Node already in the list
-        first = first->next;
-    }
-    conn = new Connection( epin, node );
-    conn->next = m_nodeAdmit;  // Prepend
-    m_nodeAdmit = conn;
+    m_nodeAdmit.emplace_back( node );
+    return m_nodeAdmit.size()-1;
+}
 
-    if( !m_nodeList.contains( node ) ) m_nodeList.append( node ); // Used by CircMatrix
+void eNode::addConnection( ePin* epin, int node )
+{
+    if( node == m_nodeNum ) return;// Be sure msg doesn't come from this node
+    if( findSlot( m_admit, epin, epin->m_admSlot ) >= 0 ) return; // Connection already in the list
+
+    epin->m_admSlot = m_admit.size();
+    m_admit.emplace_back( epin, node, nodeSlot( node ) );
 }
 
 void eNode::stampAdmitance( ePin* epin, double admit ) // Be sure msg doesn't come from this node
 {
-    Connection* conn = m_firstAdmit;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = admit; break; } // Connection found
-        conn = conn->next;
+    if( m_logicPin ) analogNet();
+
+    int i = findSlot( m_admit, epin, epin->m_admSlot );
+    if( i >= 0 ){
+        Connection& conn = m_admit[i];
+        double delta = admit-conn.value;
+        conn.value = admit;
+        m_admitSum.add( delta );
+        if( conn.slot >= 0 ) addNodeAdmit( conn.slot, delta );
     }
-
     //if( admit == 0 ) m_switched = true;
     m_admitChanged = true;
     changed();
@@ -108,33 +121,29 @@ void eNode::stampAdmitance( ePin* epin, double admit ) // Be sure msg doesn't co
 
 void eNode::addSingAdm( ePin* epin, int node, double admit )
 {
-    Connection* conn = new Connection( epin, node );
-    conn->next = m_firstSingAdm;  // Prepend
-    m_firstSingAdm = conn;
-    conn->value = admit;
+    if( m_logicPin ) analogNet();
+
+    epin->m_singSlot = m_singAdm.size();
+    m_singAdm.emplace_back( epin, node, nodeSlot( node ) );
+
+    Connection& conn = m_singAdm.back();
+    conn.value = admit;
+    if( conn.slot >= 0 ) addNodeAdmit( conn.slot, admit );
 
-    conn = NULL;
-    Connection* first = m_nodeAdmit;   // Create list of admitances to nodes (reusing Connection class)
-    while( first ){
-        if( first->node == node )  { conn = first; break; }// Node already in the list
-        first = first->next;
-    }
-    if( !conn ){
-        conn = new Connection( epin, node );
-        conn->next = m_nodeAdmit;  // Prepend
-        m_nodeAdmit = conn;
-    }
-    if( !m_nodeList.contains( node ) ) m_nodeList.append( node ); // Used by CircMatrix
     m_admitChanged = true;
     changed();
 }
 
 void eNode::stampSingAdm( ePin* epin, double admit )
 {
-    Connection* conn = m_firstSingAdm;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = admit; break; } // Connection found
-        conn = conn->next;
+    if( m_logicPin ) analogNet();
+
+    int i = findSlot( m_singAdm, epin, epin->m_singSlot );
+    if( i >= 0 ){
+        Connection& conn = m_singAdm[i];
+        double delta = admit-conn.value;
+        conn.value = admit;
+        if( conn.slot >= 0 ) addNodeAdmit( conn.slot, delta );
     }
     /// if( admit == 0 ) m_switched = true;
     m_admitChanged = true;
@@ -143,25 +152,24 @@ void eNode::stampSingAdm( ePin* epin, double admit )
 
 void eNode::createCurrent( ePin* epin )
 {
-    Connection* first = m_firstCurrent;
+    if( findSlot( m_current, epin, epin->m_curSlot ) >= 0 ) return; // Element already in the list
 
-    while( first ){
-        if( first->epin == epin ) return; // Element already in the list
-        first = first->next;
-    }
-    Connection* conn = new Connection( epin );
-    conn->next = m_firstCurrent;  // Prepend
-    m_firstCurrent = conn;
+    epin->m_curSlot = m_current.size();
+    m_current.emplace_back( epin );
 }
 
 void eNode::stampCurrent( ePin* epin, double current ) // Be sure msg doesn't come from this node
 {
-    Connection* conn = m_firstCurrent;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = current; break; } // Connection found
-        conn = conn->next;
+    if( m_logicPin && epin != m_logicPin ) analogNet();
+
+    int i = findSlot( m_current, epin, epin->m_curSlot );
+    if( i >= 0 ){
+        Connection& conn = m_current[i];
+        m_currSum.add( current-conn.value );
+        conn.value = current;
     }
-    m_currChanged = true;
+    if( m_logicPin ) m_totalCurr = m_currSum.value(); // Logic net: no need to stamp Matrix
+    else             m_currChanged = true;
     changed();
 }
 
@@ -177,64 +185,26 @@ void eNode::stampMatrix()
     if( m_nodeNum == 0 ) return;
     m_changed = false;
 
+    if( m_logicPin ){ solveSingle(); return; }
+
     if( m_admitChanged )
     {
-        m_totalAdmit = 0;
+        m_totalAdmit = m_admitSum.value();
         //if( m_switched ) m_totalAdmit += 1e-12; // Weak connection to ground
 
-        if( m_single ){
-            Connection* conn = m_firstAdmit;
-            while( conn ){ m_totalAdmit += conn->value; conn = conn->next; } // Calculate total admitance
-        }else{
-            Connection* na = m_nodeAdmit;
-            while( na ){ na->value = 0; na = na->next; } // Clear nodeAdmit
-
-            Connection* conn = m_firstAdmit; // Full Admitances
-            while( conn ){
-                double adm = conn->value;
-                int  enode = conn->node;
-
-                if( enode > 0 ){        // Calculate admitances to nodes
-                    na = m_nodeAdmit;
-                    while( na ){
-                        if( na->node == enode ){ na->value += adm; break; }
-                        na = na->next;
-                    }
-                }
-                m_totalAdmit += adm;    // Calculate total admitance
-                conn = conn->next;
-            }
-            CircMatrix::self()->stampDiagonal( m_nodeGroup, m_nodeNum, m_totalAdmit ); // Stamp diagonal
-
-            conn = m_firstSingAdm;      // Single admitance values
-            while( conn ){
-                double adm = conn->value;
-                int  enode = conn->node;
-
-                if( enode > 0 ){        // Add sinle admitance to node
-                    na = m_nodeAdmit;
-                    while( na ){
-                        if( na->node == enode ){ na->value += adm; break; }
-                        na = na->next;
-                    }
-                }
-                conn = conn->next;
-            }
-            na = m_nodeAdmit;
-            while( na ){                  // Stamp non diagonal
-                int    enode = na->node;
-                double admit = na->value;
-                if( enode > 0 ) CircMatrix::self()->stampMatrix( m_nodeNum, enode, -admit );
-                na = na->next;
-            }
+        if( !m_single ) CircMatrix::self()->stampDiagonal( m_nodeGroup, m_nodeNum, m_totalAdmit ); // Stamp diagonal
+
+        for( int slot : m_changedAdmit ) // Stamp changed non diagonal
+        {
+            NodeAdmit& na = m_nodeAdmit[slot];
+            na.changed = false;
+            if( !m_single ) CircMatrix::self()->stampMatrix( m_nodeNum, na.node, -na.admit.value() );
         }
+        m_changedAdmit.clear();
         m_admitChanged = false;
     }
     if( m_currChanged ){
-        m_totalCurr  = 0;
-
-        Connection* conn = m_firstCurrent;
-        while( conn ){ m_totalCurr += conn->value; conn = conn->next; } // Calculate total current
+        m_totalCurr = m_currSum.value();
 
         if( !m_single ) CircMatrix::self()->stampCoef(  m_nodeGroup, m_nodeNum, m_totalCurr );
         m_currChanged  = false;
@@ -251,6 +221,53 @@ void eNode::solveSingle()
     setVolt( volt );
 }
 
+// Logic net: single eNode with only IoPins stamping and just one of them driving.
+// Other pins stamps are constant, so Volt is solved from driver current only.
+// Any other stamp turns it back to a normal (analog) node.
+void eNode::checkLogic()
+{
+    m_logicPin = NULL;
+    if( !m_single || m_nodeNum == 0 ) return;
+    if( !m_singAdm.empty() ) return;
+
+    ePin* driver = NULL;
+    for( Connection& conn : m_admit ) // Pins not stamping (wires, junctions, probes) don't matter
+    {
+        IoPin* iopin = dynamic_cast<IoPin*>( conn.epin );
+        if( !iopin ) return;                    // Not only logic pins
+        if( iopin->pinMode() > openCo && !iopin->stateZ() )
+        {
+            if( driver ) return;                // More than one driver
+            driver = conn.epin;
+        }
+    }
+    if( !driver ) return;
+
+    bool driverCurr = false;
+    for( Connection& conn : m_current )
+    {
+        if( conn.epin == driver ) driverCurr = true;
+        else if( !dynamic_cast<IoPin*>( conn.epin ) ) return;
+    }
+    if( !driverCurr ) return;
+
+    m_logicPin   = driver;
+    m_totalCurr  = m_currSum.value();
+    m_totalAdmit = m_admitSum.value();
+    m_changedAdmit.clear(); // Single eNode: no Matrix entries
+    for( NodeAdmit& na : m_nodeAdmit ) na.changed = false;
+    m_admitChanged = false;
+    m_currChanged  = false;
+}
+
+void eNode::analogNet() // Back to normal eNode
+{
+    m_logicPin     = NULL;
+    m_admitChanged = true;
+    m_currChanged  = true;
+    changed();
+}
+
 void  eNode::setVolt( double v )
 {
     if( m_volt == v ) return;
@@ -364,12 +381,3 @@ void eNode::clearElmList( CallBackElement* first )
         delete del;
     }
 }
-
-void eNode::clearConnList( Connection* first )
-{
-    while( first ){
-        Connection* del = first;
-        first = first->next;
-        delete del;
-    }
-}
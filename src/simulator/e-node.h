@@ -7,6 +7,8 @@
 #define ENODE_H
 
 #include<QHash>
+#include <vector>
+#include <math.h>
 
 class ePin;
 class eElement;
@@ -52,6 +54,8 @@ class eNode
         void stampMatrix();
 
         void setSingle( bool single ) { m_single = single; } // This eNode can calculate it's own Volt
+        void checkLogic();
+        bool isLogic() { return m_logicPin != NULL; }
         //void setSwitched( bool switched ){ m_switched = switched; } // This eNode has switches attached
 
         void updateConnectors();
@@ -66,14 +70,41 @@ class eNode
         class Connection
         {
             public:
-                Connection( ePin* e, int n=0, double v=0 ){ epin = e; node = n; value = v; }
-                ~Connection(){;}
+                Connection( ePin* e, int n=0, int s=-1 ){ epin = e; node = n; slot = s; value = 0; }
 
-                Connection* next;
                 ePin*  epin;
                 int    node;
+                int    slot;  // Index in m_nodeAdmit, -1 if no matrix entry
                 double value;
         };
+        class Sum  // Running sum updated by deltas, compensated to avoid drift
+        {
+            public:
+                Sum(){ clear(); }
+
+                void clear() { sum = 0; comp = 0; }
+                void add( double v )
+                {
+                    double t = sum+v;
+                    if( fabs( sum ) >= fabs( v ) ) comp += (sum-t)+v;
+                    else                           comp += (v-t)+sum;
+                    sum = t;
+                }
+                double value() { return sum+comp; }
+
+            private:
+                double sum;
+                double comp;
+        };
+        class NodeAdmit
+        {
+            public:
+                NodeAdmit( int n ){ node = n; changed = false; }
+
+                int  node;
+                bool changed;
+                Sum  admit;
+        };
         class CallBackElement
         {
             public:
@@ -87,9 +118,13 @@ class eNode
         inline void changed();
 
         inline void solveSingle();
+        inline void analogNet();
+
+        inline int  findSlot( std::vector<Connection> &list, ePin* epin, int &slot );
+        inline void addNodeAdmit( int slot, double delta );
+        int nodeSlot( int node );
 
         void clearElmList( CallBackElement* first );
-        void clearConnList( Connection* first );
 
         QString m_id;
 
@@ -98,10 +133,16 @@ class eNode
         CallBackElement* m_voltChEl;
         CallBackElement* m_nonLinEl;
 
-        Connection* m_firstAdmit;   // Stamp full admitance in Admitance Matrix
-        Connection* m_firstSingAdm; // Stamp single value   in Admitance Matrix
-        Connection* m_firstCurrent; // Stamp value in Current Vector
-        Connection* m_nodeAdmit;
+        std::vector<Connection> m_admit;    // Stamp full admitance in Admitance Matrix
+        std::vector<Connection> m_singAdm;  // Stamp single value   in Admitance Matrix
+        std::vector<Connection> m_current;  // Stamp value in Current Vector
+        std::vector<NodeAdmit>  m_nodeAdmit;// Admitances to other nodes
+        std::vector<int> m_changedAdmit;    // m_nodeAdmit slots to stamp in Matrix
+
+        ePin* m_logicPin;    // Logic net: the only pin changing stamps
+
+        Sum m_admitSum;
+        Sum m_currSum;
 
         QList<int> m_nodeList;
 
@@ -13,6 +13,9 @@ ePin::ePin( QString id, int index )
     m_enode = NULL;
     m_enodeComp = NULL;
     m_inverted = false;
+    m_admSlot  = -1;
+    m_singSlot = -1;
+    m_curSlot  = -1;
 }
 ePin::~ePin()
 {
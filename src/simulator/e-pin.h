@@ -15,6 +15,8 @@ class Pin;
 
 class ePin
 {
+    friend class eNode;
+
     public:
         ePin( QString id, int index );
         virtual ~ePin();
@@ -54,6 +56,10 @@ class ePin
         QString m_id;
         int m_index;
 
+        int m_admSlot;  // Slots in eNode stamp lists (checked by eNode)
+        int m_singSlot;
+        int m_curSlot;
+
         bool m_inverted;
 };
 
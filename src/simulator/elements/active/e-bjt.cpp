@@ -104,8 +104,14 @@ void eBJT::voltChanged()
     if( gmin > .1 ) gmin = .1;
 
     voltBC = pnp*limitStep( pnp*voltBC, pnp*m_voltBC );
-    m_voltBC = voltBC;
     voltBE = pnp*limitStep( pnp*voltBE, pnp*m_voltBE );
+
+    double damp = Simulator::self()->nlDamping();
+    if( damp < 1 ){                   // Damped step
+        voltBC = m_voltBC + damp*(voltBC-m_voltBC);
+        voltBE = m_voltBE + damp*(voltBE-m_voltBE);
+    }
+    m_voltBC = voltBC;
     m_voltBE = voltBE;
 
     double pcoef = pnp/m_vt;
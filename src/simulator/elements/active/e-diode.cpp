@@ -76,6 +76,8 @@ void eDiode::voltChanged()
             voltPN = limitStep( voltPN, vold, m_vt, m_vzCrit );
         voltPN = -(voltPN+m_zOfset);
     }
+    double damp = Simulator::self()->nlDamping();
+    if( damp < 1 ) voltPN = m_voltPN + damp*(voltPN-m_voltPN); // Damped step
     m_voltPN = voltPN;
 
     double eval = qExp( voltPN*m_vdCoef );
@@ -93,6 +93,9 @@ void eMosfet::voltChanged()
     if( qFabs(current-m_lastCurrent)<m_accuracy ) return; // Converged
     Simulator::self()->notCorverged();
 
+    double damp = Simulator::self()->nlDamping();
+    if( damp < 1 ) current = m_lastCurrent + damp*(current-m_lastCurrent); // Damped step
+
     m_lastCurrent = current;
     m_ePin[0]->stampCurrent( current );
     m_ePin[1]->stampCurrent(-current );
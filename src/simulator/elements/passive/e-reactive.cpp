@@ -3,11 +3,15 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <math.h>
+
 #include "e-reactive.h"
 #include "e-pin.h"
 #include "e-node.h"
 #include "simulator.h"
 
+#define MAX_STEP_EXP 10 // Adaptive step up to 1024 times minimum step
+
 eReactive::eReactive( QString id )
          : eResistor( id )
 {
@@ -15,22 +19,44 @@ eReactive::eReactive( QString id )
     m_reacStep = 0;
     m_InitCurr = 0;
     m_InitVolt = 0;
+    m_absTol   = 1e-4;
+    m_relTol   = 1e-3;
+    m_method   = reactEuler;
+    m_stepMethod = reactEuler;
+    m_adaptive = false;
+    m_stepExp  = 0;
+    m_srcKeep  = 0;
+    m_stepper  = nullptr;
+    m_stepIndex = -1;
+    m_tSteps[0] = m_tSteps[1] = 0;
 }
 eReactive::~eReactive(){}
 
 void eReactive::stamp()
 {
     eResistor::stamp();
+    m_stepper = nullptr; // Steppers are created again at Simulation start
 
     if( m_ePin[0]->isConnected() && m_ePin[1]->isConnected())
     {
         m_ePin[0]->createCurrent();
         m_ePin[1]->createCurrent();
 
+        m_method   = (reactMethod_t)Simulator::self()->reactMethod();
+        m_adaptive = Simulator::self()->reactAdaptive();
+        m_tSteps[0] = m_tSteps[1] = 0;
+        m_stepMethod = reactEuler;
         updtReactStep();
 
         m_volt = m_InitVolt;
-        m_curSource = m_InitCurr;
+        m_curr = -m_InitCurr;
+        m_voltSolved = m_volt;
+        m_lastTime = 0;
+
+        m_state[0] = m_state[1] = m_state[2] = stateVar(); // Circuit was steady before start
+        m_history = 1;
+        m_tSteps[0] = m_tSteps[1] = m_tStep;
+
         m_curSource = updtCurr();
 
         if( m_curSource )
@@ -40,40 +66,325 @@ void eReactive::stamp()
         }
         m_ePin[0]->changeCallBack( this );
         m_ePin[1]->changeCallBack( this );
+
+        if( Simulator::self()->reactSync() && !m_adaptive ) Simulator::self()->addToReactSync( this );
     }
     m_running = false;
 }
 
 void eReactive::voltChanged()
 {
-    if( m_running ) return;
+    if( m_running )
+    {
+        if( !m_stepExp ) return;
+
+        double volt = m_ePin[0]->getVoltage() - m_ePin[1]->getVoltage();
+        if( Simulator::self()->circTime() == m_lastTime ) // Solution for our last step
+        {
+            m_voltSolved = volt;
+            return;
+        }
+        if( fabs( volt-m_voltSolved ) <= m_relTol*fabs( volt )+1e-4 ) return;
+
+        // Edge during a long step: integrate elapsed part of the step and restart from there
+        Simulator::self()->cancelEvents( this );
+        integrate( (double)(Simulator::self()->circTime()-m_lastTime)/m_timeStep, m_voltSolved );
+        restart();
+        return;
+    }
     m_running = true;
-    Simulator::self()->addEvent( m_timeStep, this );
+    m_lastTime = Simulator::self()->circTime();
+    schedule();
 }
 
 void eReactive::runEvent()
 {
     double volt = m_ePin[0]->getVoltage() - m_ePin[1]->getVoltage();
 
-    if( m_volt != volt )
+    if( m_method == reactEuler && !m_adaptive ) // Fixed step Backward Euler
     {
-        m_volt = volt;
-        m_curSource = updtCurr();
+        if( m_volt != volt )
+        {
+            m_curr = volt*m_admit - m_curSource;
+            m_volt = volt;
+            m_curSource = updtCurr();
 
-        m_ePin[0]->stampCurrent( m_curSource );
-        m_ePin[1]->stampCurrent(-m_curSource );
-        Simulator::self()->addEvent( m_timeStep, this );
+            m_ePin[0]->stampCurrent( m_curSource );
+            m_ePin[1]->stampCurrent(-m_curSource );
+            schedule();
+        }
+        else m_running = false;
+        return;
     }
-    else m_running = false;
+    double deltaV = volt-m_volt;
+    m_curr = volt*m_admit - m_curSource; // Current at end of this step
+    m_volt = volt;
+    double x = stateVar();
+
+    if( fabs( deltaV ) < 1e-10 && fabs( x-m_state[0] ) < 1e-6*m_absTol ) // Steady
+    {
+        m_running = false;
+        m_state[0] = m_state[1] = m_state[2] = x;
+        m_history = 1;
+        if( m_stepExp || m_stepMethod != reactEuler ) // Next change starts at minimum step
+        {
+            m_stepMethod = reactEuler;
+            setStep( 0 );
+            m_curSource = updtCurr();
+            m_ePin[0]->stampCurrent( m_curSource );
+            m_ePin[1]->stampCurrent(-m_curSource );
+        }
+        return;
+    }
+    int stepExp = m_stepExp;
+    if( m_adaptive ) updtStepExp( x );
+
+    m_state[2] = m_state[1];
+    m_state[1] = m_state[0];
+    m_state[0] = x;
+    if( m_history < 3 ) m_history++;
+
+    m_tSteps[1] = m_tSteps[0];
+    m_tSteps[0] = m_tStep;
+
+    reactMethod_t stepMethod = m_stepMethod;
+    m_stepMethod = m_method; // History is valid now
+
+    if( stepExp != m_stepExp ) setStep( m_stepExp );
+    else if( stepMethod != m_stepMethod
+         || (m_method == reactGear2 && m_tSteps[0] != m_tSteps[1]) ) // Step ratio changed
+        eResistor::setResistance( updtRes() );
+
+    stampCompanion();
 }
 
-void eReactive::updtReactStep()
+// Backward Euler over a fraction of current step, volt: solved voltage for the step
+// State variable moves with elapsed time, the other keeps its value for the step
+void eReactive::integrate( double frac, double volt )
+{
+    double curr = volt*m_admit - m_curSource; // Current during this step
+    if( m_srcKeep ){ m_curr += frac*(curr-m_curr); m_volt = volt; } // Inductor
+    else           { m_volt += frac*(volt-m_volt); m_curr = curr; } // Capacitor
+}
+
+void eReactive::restart() // Start again from current state at minimum step
+{
+    m_state[0] = m_state[1] = m_state[2] = stateVar();
+    m_history = 1;
+    m_stepMethod = reactEuler;
+    setStep( 0 );
+    stampCompanion();
+}
+
+void eReactive::stampCompanion() // Stamp current source and schedule next step
+{
+    m_curSource = updtCurr();
+
+    m_ePin[0]->stampCurrent( m_curSource );
+    m_ePin[1]->stampCurrent(-m_curSource );
+
+    m_voltSolved = m_ePin[0]->getVoltage() - m_ePin[1]->getVoltage(); // Updated if solution changes
+    m_lastTime = Simulator::self()->circTime();
+    schedule();
+}
+
+inline void eReactive::schedule() // Next step: own event or synchronized step
+{
+    if( m_stepper ) m_stepper->activate( m_stepIndex );
+    else            Simulator::self()->addEvent( m_timeStep, this );
+}
+
+void eReactive::updtStepExp( double x ) // Local truncation error step control
+{
+    int order = (m_stepMethod == reactEuler) ? 1 : 2;
+    if( m_history < order+1 ) return;
+
+    double h1 = m_tStep;
+    double h2 = m_tSteps[0];
+    double d1 = (x-m_state[0])/h1;
+    double d2 = (m_state[0]-m_state[1])/h2;
+    double dd = (d1-d2)/(h1+h2);       // Second divided difference
+    double lte;
+
+    if( order == 1 ) lte = h1*h1*fabs( dd );    // h²·x''/2
+    else{
+        double h3 = m_tSteps[1];
+        double d3 = (m_state[1]-m_state[2])/h3;
+        double ddd = (dd-(d2-d3)/(h2+h3))/(h1+h2+h3); // Third divided difference
+        lte = h1*h1*h1*fabs( ddd );
+        if( m_stepMethod == reactTrapezoidal ) lte *= 0.5;  // h³·x'''/12
+        else                               lte *= 4.0/3; // 2·h³·x'''/9
+    }
+    double tol = m_relTol*fmax( fabs( x ), fabs( m_state[0] ) )+m_absTol;
+    double factor = 1<<(order+1); // Error change when step is doubled/halved
+
+    if( lte > tol )
+    {
+        while( lte > tol && m_stepExp > 0 ){ lte /= factor; m_stepExp--; }
+    }
+    else if( lte*factor < tol*0.5 && m_stepExp < MAX_STEP_EXP ) m_stepExp++;
+}
+
+void eReactive::setStep( int exp )
 {
-    if( m_reacStep ) m_timeStep = m_reacStep;
-    else             m_timeStep = Simulator::self()->reactStep(); // Time in ps
-    m_tStep = (double)m_timeStep/1e12;         // Time in seconds
+    m_stepExp  = exp;
+    m_timeStep = m_baseStep << exp;
+    m_tStep = (double)m_timeStep/1e12; // Time in seconds
     eResistor::setResistance( updtRes() );
+}
+
+void eReactive::updtReactStep()
+{
+    if( m_reacStep ) m_baseStep = m_reacStep;
+    else             m_baseStep = Simulator::self()->reactStep(); // Time in ps
+    setStep( 0 );
 
     m_running = false;
     Simulator::self()->cancelEvents( this );
+
+    if( m_stepper ) // Step could have changed
+    {
+        m_stepper->remReactive( m_stepIndex );
+        m_stepper = nullptr;
+        if( Simulator::self()->isRunning() ) joinStepper( Simulator::self()->reactStepper( m_timeStep ) );
+    }
+}
+
+void eReactive::joinStepper( eReactStepper* stepper )
+{
+    m_stepper = stepper;
+    m_stepIndex = stepper->addReactive( this );
+}
+
+//------------------------------------------------------------
+// eReactStepper
+
+eReactStepper::eReactStepper( uint64_t step )
+             : eElement( "reactStepper-"+QString::number( step ) )
+{
+    m_timeStep  = step;
+    m_scheduled = false;
+}
+eReactStepper::~eReactStepper(){}
+
+int eReactStepper::addReactive( eReactive* r )
+{
+    m_reactive.push_back( r );
+    m_active.push_back( 0 );
+    m_volt.push_back( 0 );
+    m_newVolt.push_back( 0 );
+    m_admit.push_back( 0 );
+    m_curSource.push_back( 0 );
+    m_newSource.push_back( 0 );
+    m_srcKeep.push_back( r->m_srcKeep );
+
+    return m_reactive.size()-1;
+}
+
+void eReactStepper::remReactive( int i ) // Move last member to this slot
+{
+    uint last = m_reactive.size()-1;
+    if( (uint)i != last )
+    {
+        m_reactive[i]  = m_reactive[last];
+        m_active[i]    = m_active[last];
+        m_volt[i]      = m_volt[last];
+        m_newVolt[i]   = m_newVolt[last];
+        m_admit[i]     = m_admit[last];
+        m_curSource[i] = m_curSource[last];
+        m_newSource[i] = m_newSource[last];
+        m_srcKeep[i]   = m_srcKeep[last];
+        m_reactive[i]->m_stepIndex = i;
+    }
+    m_reactive.pop_back();
+    m_active.pop_back();
+    m_volt.pop_back();
+    m_newVolt.pop_back();
+    m_admit.pop_back();
+    m_curSource.pop_back();
+    m_newSource.pop_back();
+    m_srcKeep.pop_back();
+}
+
+void eReactStepper::activate( int i )
+{
+    eReactive* r = m_reactive[i];
+    m_volt[i]      = r->m_volt;
+    m_admit[i]     = r->m_admit;
+    m_curSource[i] = r->m_curSource;
+
+    if( m_scheduled ) // Next event less than a full step away: first step integrates elapsed time only
+    {
+        if( !m_active[i] ) m_active[i] = (eventTime-Simulator::self()->circTime() < m_timeStep) ? 2 : 1;
+        return;
+    }
+    m_active[i] = 1;
+    m_scheduled = true;
+    Simulator::self()->addEvent( m_timeStep, this );
+}
+
+void eReactStepper::runEvent()
+{
+    m_scheduled = false;
+    uint64_t time = Simulator::self()->circTime();
+    uint n = m_reactive.size();
+
+    for( uint i=0; i<n; ++i ) // Get voltages
+    {
+        if( !m_active[i] ) continue;
+        eReactive* r = m_reactive[i];
+        double volt = r->m_ePin[0]->getVoltage() - r->m_ePin[1]->getVoltage();
+
+        if( r->m_method != reactEuler ) // Other methods run their own step
+        {
+            bool partial = m_active[i] == 2;
+            m_active[i] = 0;
+            if( partial ){                 // Joined after this event was scheduled
+                r->integrate( (double)(time-r->m_lastTime)/m_timeStep, volt );
+                r->restart();
+            }
+            else r->runEvent(); // Activated again if not steady
+            continue;
+        }
+        m_newVolt[i] = volt;
+    }
+    // Backward Euler sources: Capacitor s = G*v, Inductor s = s-G*v
+    for( uint i=0; i<n; ++i )
+        m_newSource[i] = m_srcKeep[i]*m_curSource[i] + (1-2*m_srcKeep[i])*m_admit[i]*m_newVolt[i];
+
+    bool active = false;
+    for( uint i=0; i<n; ++i ) // Stamp changed sources
+    {
+        if( !m_active[i] ) continue;
+        eReactive* r = m_reactive[i];
+        if( r->m_method != reactEuler ) continue;
+
+        if( m_active[i] == 2 ) // Joined after this event was scheduled: step over elapsed time
+        {
+            m_active[i] = 1;
+            r->integrate( (double)(time-r->m_lastTime)/m_timeStep, m_newVolt[i] );
+            m_newSource[i] = r->updtCurr();
+        }
+        else if( m_newVolt[i] == m_volt[i] ) // Steady
+        {
+            m_active[i] = 0;
+            r->m_running = false;
+            continue;
+        }
+        else{
+            r->m_curr = m_newVolt[i]*m_admit[i] - m_curSource[i];
+            r->m_volt = m_newVolt[i];
+        }
+        m_volt[i] = r->m_volt;
+        r->m_curSource = m_curSource[i] = m_newSource[i];
+
+        r->m_ePin[0]->stampCurrent( m_newSource[i] );
+        r->m_ePin[1]->stampCurrent(-m_newSource[i] );
+        active = true;
+    }
+    if( active && !m_scheduled )
+    {
+        m_scheduled = true;
+        Simulator::self()->addEvent( m_timeStep, this );
+    }
 }
@@ -8,8 +8,18 @@
 
 #include "e-resistor.h"
 
+enum reactMethod_t{     // Integration method for reactive elements
+    reactEuler=0,       // Backward Euler
+    reactTrapezoidal,
+    reactGear2,         // Gear 2nd order (BDF2)
+};
+
+class eReactStepper;
+
 class eReactive : public eResistor
 {
+        friend class eReactStepper;
+
     public:
         eReactive( QString id );
         ~eReactive();
@@ -24,26 +34,86 @@ class eReactive : public eResistor
         double initCurr() { return -m_InitCurr; }
         void setInitCurr( double c ) { m_InitCurr = -c; }
 
+        uint64_t timeStep() { return m_timeStep; }
+        void joinStepper( eReactStepper* stepper );
+
     protected:
         void updtReactStep();
+        void setStep( int exp );
+        void stampCompanion();
+        void integrate( double frac, double volt );
+        void restart();
+        void updtStepExp( double x );
+
+        inline void schedule();
 
         virtual double updtRes(){ return 0.0;}
         virtual double updtCurr(){ return 0.0;}
+        virtual double stateVar(){ return m_volt; } // Variable for error control: Voltage or Current
+
+        double gearRatio() { return m_tSteps[0] > 0 ? m_tStep/m_tSteps[0] : 1; } // Gear2: step/last step
 
         double m_value; // Capacitance or Inductance
 
         double m_InitCurr;
         double m_curSource;
+        double m_curr;          // Current at last step
+        double m_srcKeep;       // Backward Euler source: 0 from Voltage (Capacitor), 1 accumulates (Inductor)
 
         double m_InitVolt;
-        double m_volt;
+        double m_volt;          // Voltage at last step
+        double m_voltSolved;    // Voltage solved after last step (edge detection)
+
+        double m_tStep;         // Current step in seconds
+        double m_tSteps[2];     // Last 2 completed steps in seconds
+        double m_state[3];      // stateVar() at last 3 steps
+        double m_absTol;        // Absolute tolerance for stateVar()
+        double m_relTol;
 
-        double m_tStep;
+        reactMethod_t m_method;
+        reactMethod_t m_stepMethod; // Method for current step: Backward Euler after discontinuities
 
         uint64_t m_reacStep;
         uint64_t m_timeStep;
+        uint64_t m_baseStep;    // Minimum step for adaptive step
+        uint64_t m_lastTime;    // Time of last step
 
+        int m_stepExp;          // Adaptive step: m_timeStep = m_baseStep<<m_stepExp
+        int m_history;          // Number of valid m_state values
+
+        bool m_adaptive;
         bool m_running;
+
+        eReactStepper* m_stepper; // Synchronized step: shared event for all with same step
+        int m_stepIndex;
+};
+
+// Synchronized reactive step: one event for all eReactive with same step size.
+// Backward Euler companion sources are updated in a batch over contiguous arrays.
+class eReactStepper : public eElement
+{
+    public:
+        eReactStepper( uint64_t step );
+        ~eReactStepper();
+
+        virtual void runEvent() override;
+
+        int  addReactive( eReactive* r ); // Returns index in stepper
+        void remReactive( int i );
+        void activate( int i );           // Reactive needs a step
+
+    private:
+        uint64_t m_timeStep;
+        bool     m_scheduled;
+
+        std::vector<eReactive*> m_reactive;
+        std::vector<uint8_t>    m_active;    // 0 idle, 1 stepping, 2 first step shorter than m_timeStep
+        std::vector<double>     m_volt;
+        std::vector<double>     m_newVolt;
+        std::vector<double>     m_admit;
+        std::vector<double>     m_curSource;
+        std::vector<double>     m_newSource;
+        std::vector<double>     m_srcKeep;
 };
 
 #endif
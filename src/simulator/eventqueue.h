@@ -0,0 +1,109 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <vector>
+#include <inttypes.h>
+
+// Simulator event queue: binary heap ordered by eventTime,
+// same eventTime: last added runs first (as old sorted list).
+// T must have members: uint64_t eventTime, uint64_t eventSeq, int eventIdx.
+// No Qt dependencies, so it can be used in standalone benchmarks.
+template <class T>
+class EventQueue
+{
+    public:
+        EventQueue() { m_seq = 0; }
+
+        bool empty() const { return m_heap.empty(); }
+        int   size() const { return m_heap.size(); }
+        T*   first() const { return m_heap[0]; }
+
+        void clear()
+        {
+            for( T* el : m_heap ){
+                el->eventTime = 0;
+                el->eventIdx = -1;
+            }
+            m_heap.clear();
+            m_seq = 0;
+        }
+
+        void insert( T* el, uint64_t time ) // time is absolute
+        {
+            el->eventTime = time;
+            el->eventSeq  = ++m_seq;
+            el->eventIdx  = m_heap.size();
+            m_heap.push_back( el );
+            up( el->eventIdx );
+        }
+
+        void remove( T* el ) { if( el->eventIdx >= 0 ) removeAt( el->eventIdx ); }
+
+        void removeAt( int i )
+        {
+            T* el = m_heap[i];
+            el->eventTime = 0;
+            el->eventIdx  = -1;
+
+            T* last = m_heap.back();
+            m_heap.pop_back();
+            if( last == el ) return;   // Removed last element in the heap
+
+            m_heap[i] = last;          // Fill the hole with last element and restore heap
+            last->eventIdx = i;
+            if( i > 0 && before( last, m_heap[(i-1)/2] ) ) up( i );
+            else                                          down( i );
+        }
+
+    private:
+        inline bool before( T* a, T* b )
+        {
+            if( a->eventTime != b->eventTime ) return a->eventTime < b->eventTime;
+            return a->eventSeq > b->eventSeq;
+        }
+
+        void up( int i )
+        {
+            T* el = m_heap[i];
+            while( i > 0 )
+            {
+                int parent = (i-1)/2;
+                T* pe = m_heap[parent];
+                if( !before( el, pe ) ) break;
+                m_heap[i] = pe;
+                pe->eventIdx = i;
+                i = parent;
+            }
+            m_heap[i] = el;
+            el->eventIdx = i;
+        }
+
+        void down( int i )
+        {
+            int size = m_heap.size();
+            T* el = m_heap[i];
+            while( true )
+            {
+                int child = 2*i+1;
+                if( child >= size ) break;
+                if( child+1 < size && before( m_heap[child+1], m_heap[child] ) ) child++;
+                T* ce = m_heap[child];
+                if( !before( ce, el ) ) break;
+                m_heap[i] = ce;
+                ce->eventIdx = i;
+                i = child;
+            }
+            m_heap[i] = el;
+            el->eventIdx = i;
+        }
+
+        std::vector<T*> m_heap;
+        uint64_t m_seq;
+};
+
+#endif
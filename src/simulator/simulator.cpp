@@ -5,6 +5,7 @@
 
 #include <qtconcurrentrun.h>
 #include <QHash>
+#include <QSettings>
 #include <math.h>
 
 #include "simulator.h"
@@ -17,8 +18,12 @@
 #include "circuitwidget.h"
 #include "circmatrix.h"
 #include "e-element.h"
+#include "e-reactive.h"
 #include "socket.h"
 
+#define NL_DAMP_STEPS 16 // Non Linear iterations before damping steps
+#define NL_DAMP_MAX    3 // Minimum damping factor: 1/2^NL_DAMP_MAX
+
 Simulator* Simulator::m_pSelf = NULL;
 
 Simulator::Simulator( QObject* parent )
@@ -27,6 +32,16 @@ Simulator::Simulator( QObject* parent )
     m_pSelf = this;
 
     m_matrix = new CircMatrix();
+    m_matrix->setSparse( MainWindow::self()->settings()->value("Simulator/sparseSolver").toBool() );
+    m_matrix->setLowRank( MainWindow::self()->settings()->value("Simulator/lowRankUpdates").toBool() );
+    m_matrix->setParallel( MainWindow::self()->settings()->value("Simulator/parallelSolver").toBool() );
+    m_logicNets = MainWindow::self()->settings()->value("Simulator/logicNets").toBool();
+    m_mcuQuantum = MainWindow::self()->settings()->value("Simulator/mcuQuantum").toBool();
+    m_unthrottled = MainWindow::self()->settings()->value("Simulator/unthrottled").toBool();
+    m_reactMethod   = MainWindow::self()->settings()->value("Simulator/reactMethod").toInt();
+    m_reactAdaptive = MainWindow::self()->settings()->value("Simulator/reactAdaptive").toBool();
+    m_reactSync     = MainWindow::self()->settings()->value("Simulator/reactSync").toBool();
+    m_headless   = false;
 
     m_fps = 20;
     m_timerId   = 0;
@@ -55,6 +70,7 @@ Simulator::Simulator( QObject* parent )
 Simulator::~Simulator()
 {
     m_CircuitFuture.waitForFinished();
+    clearReactSteppers();
     delete m_matrix;
 }
 
@@ -117,7 +133,10 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     m_tStep   = m_circTime;
 
     if( m_state == SIM_RUNNING ) // Run Circuit in a parallel thread
-        m_CircuitFuture = QtConcurrent::run( this, &Simulator::runCircuit );
+    {
+        if( m_unthrottled ) m_CircuitFuture = QtConcurrent::run( this, &Simulator::runContinuous );
+        else                m_CircuitFuture = QtConcurrent::run( this, &Simulator::runCircuit );
+    }
 
     if( Circuit::self()->animate() ) // Moved here to be in parallel with runCircuit thread
     {
@@ -146,36 +165,54 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
 }
 
 void Simulator::runCircuit()
+{
+    runUntil( m_circTime + m_psPF ); // Run upto next Timer event
+    m_loopTime = m_RefTimer.nsecsElapsed();
+}
+
+void Simulator::runContinuous() // Unthrottled: run until stopped at next Timer event
+{
+    while( m_state == SIM_RUNNING ) runUntil( m_circTime + m_psPF );
+    m_loopTime = m_RefTimer.nsecsElapsed();
+}
+
+void Simulator::runHeadless( uint64_t endTime ) // Run as fast as possible, no Timer or GUI updates
+{
+    while( m_state == SIM_RUNNING && m_circTime < endTime )
+    {
+        uint64_t endRun = m_circTime + m_psPF;
+        if( endRun > endTime ) endRun = endTime;
+        runUntil( endRun );
+    }
+}
+
+void Simulator::runUntil( uint64_t endRun )
 {
     solveCircuit(); // Solve any pending changes
     if( m_state < SIM_RUNNING ) return;
 
-    eElement* event = m_firstEvent;
-    uint64_t endRun = m_circTime + m_psPF; // Run upto next Timer event
+    m_endRun = endRun;
     uint64_t nextTime;
 
-    while( event )                              // Simulator event loop
+    while( !m_eventQueue.empty() )              // Simulator event loop
     {
+        eElement* event = m_eventQueue.first();
         if( event->eventTime > endRun ) break;  // All events for this Timer Tick are done
 
         nextTime = m_circTime;
         while( m_circTime == nextTime )         // Run all event with same timeStamp
         {
             m_circTime = event->eventTime;
-            m_firstEvent = event->nextEvent;    // free Event
-            event->nextEvent = NULL;
-            event->eventTime = 0;
+            m_eventQueue.removeAt( 0 );         // free Event
             event->runEvent();                  // Run event callback
-            event = m_firstEvent;
-            if( event ) nextTime = event->eventTime;
-            else break;
+            if( m_eventQueue.empty() ) break;
+            event = m_eventQueue.first();
+            nextTime = event->eventTime;
         }
         solveCircuit();
         if( m_state < SIM_RUNNING ) break;
-        event = m_firstEvent;               // m_firstEvent can be an event added at solveCircuit()
     }
     if( m_state > SIM_WAITING ) m_circTime = endRun;
-    m_loopTime = m_RefTimer.nsecsElapsed();
 }
 
 void Simulator::solveCircuit()
@@ -187,19 +224,25 @@ void Simulator::solveCircuit()
         if( m_converged ) m_converged = m_nonLinear==NULL;
         while( !m_converged )              // Non Linear Components
         {
+            // Not converging: halve Newton steps every NL_DAMP_STEPS iterations
+            uint32_t damp = m_NLstep/NL_DAMP_STEPS;
+            m_nlDamping = 1.0/(1 << ((damp < NL_DAMP_MAX) ? damp : NL_DAMP_MAX));
+
             m_converged = true;
             while( m_nonLinear ){
                 m_nonLinear->added = false;
                 m_nonLinear->voltChanged();
                 m_nonLinear = m_nonLinear->nextChanged;
             }
-            if( m_maxNlstp && (m_NLstep++ >= m_maxNlstp) ) { m_warning = 1; return; } // Max iterations reached
+            m_NLstep++;
+            if( m_maxNlstp && m_NLstep >= m_maxNlstp ) { m_warning = 1; return; } // Max iterations reached
             if( m_state < SIM_RUNNING ){ m_converged = false; break; }    // Loop broken without converging
             if( m_changedNode ) solveMatrix();
         }
         if( !m_converged ) return; // Don't run linear until nonliear converged (Loop broken)
 
         m_NLstep = 0;
+        m_nlDamping = 1;
         while( m_voltChanged )
         {
             m_voltChanged->added = false;
@@ -213,6 +256,7 @@ void Simulator::solveCircuit()
 void Simulator::resetSim()
 {
     m_state    = SIM_STOPPED;
+    m_endRun   = 0;
     m_simLoad  = 0;
     m_guiTime  = 0;
     m_error    = 0;
@@ -223,6 +267,7 @@ void Simulator::resetSim()
     m_circTime = 1;
     m_updtTime = 0;
     m_NLstep   = 0;
+    m_nlDamping = 1;
     ///m_pauseCirc = false;
     m_simPsPF = 1;
 
@@ -274,6 +319,7 @@ void Simulator::createNodes()
 void Simulator::startSim( bool paused )
 {
     resetSim();
+    clearReactSteppers();
     setPsPerSec( m_psPerSec );
     m_debug = paused;
     m_state = SIM_STARTING;
@@ -303,8 +349,14 @@ void Simulator::startSim( bool paused )
     }
     for( eElement* el : m_elementList ) el->stamp();
 
+    for( eReactive* el : m_reactSyncList ) el->joinStepper( reactStepper( el->timeStep() ) );
+    m_reactSyncList.clear();
+
     m_matrix->createMatrix( m_eNodeList );
 
+    if( m_logicNets )  // Nodes driven by 1 logic output with only logic inputs
+        for( eNode* enode : m_eNodeList ) enode->checkLogic();
+
     /// qDebug() << "\nCircuit Matrix looks good";
 
     /*double sps100 = 100*(double)m_psPerSec/1e12; // Speed %
@@ -325,6 +377,8 @@ void Simulator::startSim( bool paused )
     }
     else m_state = SIM_RUNNING;
 
+    if( m_headless ) return; // Driven by runHeadless()
+
     if( m_timerId != 0 ) this->killTimer( m_timerId );               // Stop Timer
     m_refTime  = m_RefTimer.nsecsElapsed();
     m_loopTime = m_refTime;
@@ -347,7 +401,8 @@ void Simulator::stopSim()
 
     for( eNode* node  : m_eNodeList  )  node->setVolt( 0 );
     for( eElement* el : m_elementList ) el->initialize();
-    for( Updatable* el : m_updateList ) el->updateStep();
+    if( !m_headless )
+        for( Updatable* el : m_updateList ) el->updateStep();
 
     clearEventList();
     m_changedNode = NULL;
@@ -421,10 +476,89 @@ void Simulator::setPsPerSec( uint64_t psPs )
     InfoWidget::self()->setTargetSpeed( 100*m_psPerSec/1e12 );
 }
 
+bool Simulator::sparseSolver() { return m_matrix->sparse(); }
+
+void Simulator::setSparseSolver( bool s ) // Used at next Simulation start
+{
+    m_matrix->setSparse( s );
+    MainWindow::self()->settings()->setValue( "Simulator/sparseSolver", s );
+}
+
+bool Simulator::lowRankUpdates() { return m_matrix->lowRank(); }
+
+void Simulator::setLowRankUpdates( bool l ) // Used at next Simulation start
+{
+    m_matrix->setLowRank( l );
+    MainWindow::self()->settings()->setValue( "Simulator/lowRankUpdates", l );
+}
+
+bool Simulator::parallelSolver() { return m_matrix->parallel(); }
+
+void Simulator::setParallelSolver( bool p )
+{
+    m_matrix->setParallel( p );
+    MainWindow::self()->settings()->setValue( "Simulator/parallelSolver", p );
+}
+
+void Simulator::setLogicNets( bool l ) // Used at next Simulation start
+{
+    m_logicNets = l;
+    MainWindow::self()->settings()->setValue( "Simulator/logicNets", l );
+}
+
+void Simulator::setReactMethod( int m ) // Used at next Simulation start
+{
+    m_reactMethod = m;
+    MainWindow::self()->settings()->setValue( "Simulator/reactMethod", m );
+}
+
+void Simulator::setReactAdaptive( bool a ) // Used at next Simulation start
+{
+    m_reactAdaptive = a;
+    MainWindow::self()->settings()->setValue( "Simulator/reactAdaptive", a );
+}
+
+void Simulator::setReactSync( bool s ) // Used at next Simulation start
+{
+    m_reactSync = s;
+    MainWindow::self()->settings()->setValue( "Simulator/reactSync", s );
+}
+
+eReactStepper* Simulator::reactStepper( uint64_t step )
+{
+    eReactStepper* stepper = m_reactSteppers.value( step );
+    if( !stepper )
+    {
+        stepper = new eReactStepper( step );
+        m_reactSteppers[step] = stepper;
+    }
+    return stepper;
+}
+
+void Simulator::clearReactSteppers()
+{
+    for( eReactStepper* stepper : m_reactSteppers ) delete stepper;
+    m_reactSteppers.clear();
+    m_reactSyncList.clear();
+}
+
+void Simulator::setUnthrottled( bool u )
+{
+    m_unthrottled = u;
+    MainWindow::self()->settings()->setValue( "Simulator/unthrottled", u );
+}
+
+void Simulator::setMcuQuantum( bool q )
+{
+    m_mcuQuantum = q;
+    MainWindow::self()->settings()->setValue( "Simulator/mcuQuantum", q );
+}
+
 void Simulator::clearEventList()
 {
-    m_firstEvent = NULL;
+    m_eventQueue.clear();
 }
+
 void Simulator::addEvent( uint64_t time, eElement* el )
 {
     if( m_state < SIM_STARTING ) return;
@@ -432,42 +566,30 @@ void Simulator::addEvent( uint64_t time, eElement* el )
     if( el->eventTime )
     { qDebug() << "Warning: Simulator::addEvent Repeated event"<<el->getId(); return; }
 
-    time += m_circTime;
-    eElement* last  = NULL;
-    eElement* event = m_firstEvent;
+    m_eventQueue.insert( el, time + m_circTime );
+}
 
-    while( event ){
-        if( time <= event->eventTime ) break; // Insert event here
-        last  = event;
-        event = event->nextEvent;
-    }
-    el->eventTime = time;
+// Move Circuit time forward if nothing else happens before that time.
+// Used by elements running ahead of the event loop (MCU instruction batches).
+bool Simulator::advanceTime( uint64_t time )
+{
+    if( m_state != SIM_RUNNING ) return false;
+    if( m_changedNode || m_voltChanged || m_nonLinear ) return false; // Changes pending
 
-    if( last ) last->nextEvent = el;
-    else       m_firstEvent = el; // List was empty or insert First
+    time += m_circTime;
+    if( time > m_endRun ) return false;
+    if( !m_eventQueue.empty() && time >= m_eventQueue.first()->eventTime ) return false;
 
-    el->nextEvent = event;
+    m_circTime = time;
+    return true;
 }
 
 void Simulator::cancelEvents( eElement* el )
 {
     if( el->eventTime == 0 ) return;
-    eElement* event = m_firstEvent;
-    eElement* last  = NULL;
-    eElement* next  = NULL;
+    m_eventQueue.remove( el );
     el->eventTime = 0;
-
-    while( event ){
-        next = event->nextEvent;
-        if( el == event )
-        {
-            if( last ) last->nextEvent = next;
-            else       m_firstEvent = next;
-            event->nextEvent = NULL;
-        }
-        else last = event;
-        event = next;
-}   }
+}
 
 void Simulator::addToEnodeList( eNode* nod )
 { if( !m_eNodeList.contains(nod) ) m_eNodeList.append( nod ); }
@@ -8,6 +8,7 @@
 
 #include "e-node.h"
 #include "e-element.h"
+#include "eventqueue.h"
 
 enum simState_t{
     SIM_STOPPED=0,
@@ -28,6 +29,8 @@ class eElement;
 class Socket;
 class eNode;
 class CircMatrix;
+class eReactive;
+class eReactStepper;
 
 class Simulator : public QObject
 {
@@ -42,8 +45,10 @@ class Simulator : public QObject
 
          void addEvent( uint64_t time, eElement* el );
          void cancelEvents( eElement* el );
+         bool advanceTime( uint64_t time );
 
         void startSim( bool paused=false );
+        void runHeadless( uint64_t endTime );
         void pauseSim();
         void resumeSim();
         void stopSim();
@@ -67,11 +72,44 @@ class Simulator : public QObject
         uint64_t reactStep() { return m_reactStep; }
         void setReactStep( uint64_t rs ) { m_reactStep = rs; }
 
+        int reactMethod() { return m_reactMethod; }
+        void setReactMethod( int m );
+
+        bool reactAdaptive() { return m_reactAdaptive; }
+        void setReactAdaptive( bool a );
+
+        bool reactSync() { return m_reactSync; }
+        void setReactSync( bool s );
+
+        eReactStepper* reactStepper( uint64_t step ); // Get synchronized step, create if not exist
+        void addToReactSync( eReactive* r ) { m_reactSyncList.push_back( r ); }
+
         void  setSlopeSteps( int steps ) { m_slopeSteps = steps; }
         int slopeSteps( ) { return m_slopeSteps; }
 
         void  setMaxNlSteps( uint32_t steps ) { m_maxNlstp = steps; }
         uint32_t maxNlSteps( ) { return m_maxNlstp; }
+
+        bool sparseSolver();
+        void setSparseSolver( bool s );
+
+        bool lowRankUpdates();
+        void setLowRankUpdates( bool l );
+
+        bool parallelSolver();
+        void setParallelSolver( bool p );
+
+        bool logicNets() { return m_logicNets; }
+        void setLogicNets( bool l );
+
+        bool mcuQuantum() { return m_mcuQuantum; }
+        void setMcuQuantum( bool q );
+
+        bool unthrottled() { return m_unthrottled; }
+        void setUnthrottled( bool u );
+
+        bool headless() { return m_headless; }
+        void setHeadless( bool h ) { m_headless = h; }
         
         bool isRunning() { return (m_state >= SIM_STARTING); }
         bool isPaused()  { return (m_state == SIM_PAUSED); }
@@ -86,8 +124,10 @@ class Simulator : public QObject
         simState_t simState() { return m_state; }
 
         inline void notCorverged() { m_converged = false; }
+        inline double nlDamping() { return m_nlDamping; } // Factor for Non Linear steps (1 = full Newton step)
 
         void addToEnodeList( eNode* nod );
+        QList<eNode*> eNodeList() { return m_eNodeList; }
 
         void addToElementList( eElement* el );
         void remFromElementList( eElement* el );
@@ -109,15 +149,18 @@ class Simulator : public QObject
         void createNodes();
         void resetSim();
         void runCircuit();
+        void runContinuous();
+        void runUntil( uint64_t endRun );
         inline void solveCircuit();
         inline void solveMatrix();
 
         inline void clearEventList();
+        void clearReactSteppers();
 
         //inline void stopTimer();
         //inline void initTimer();
 
-        eElement* m_firstEvent;
+        EventQueue<eElement> m_eventQueue;
 
         QFuture<void> m_CircuitFuture;
 
@@ -136,10 +179,19 @@ class Simulator : public QObject
         QList<Updatable*> m_updateList;
         QList<Socket*> m_socketList;
 
+        QHash<uint64_t, eReactStepper*> m_reactSteppers;
+        std::vector<eReactive*> m_reactSyncList; // Joining a stepper after stamp
+
         simState_t m_state;
         simState_t m_oldState;
 
         bool m_debug;
+        bool m_logicNets;
+        bool m_mcuQuantum;
+        bool m_headless;
+        bool m_unthrottled;
+        bool m_reactAdaptive;
+        bool m_reactSync;
         bool m_converged;
         bool m_pauseCirc;
 
@@ -148,8 +200,10 @@ class Simulator : public QObject
         int m_timerId;
         int m_timerTick_ms;
         int m_slopeSteps;
+        int m_reactMethod;
 
         double m_realFPS;
+        double m_nlDamping;
         uint64_t m_fps;
         uint32_t m_NLstep;
         uint32_t m_maxNlstp;
@@ -164,6 +218,7 @@ class Simulator : public QObject
 
         uint64_t m_timerTime;
         uint64_t m_circTime;
+        uint64_t m_endRun;
         uint64_t m_tStep;
         uint64_t m_lastStep;
         uint64_t m_refTime;
@@ -9,6 +9,7 @@
 #include <QDebug>
 #include <QFile>
 #include <QFileInfo>
+#include <QDateTime>
 #include <QMessageBox>
 #include <QTextStream>
 #include <qpoint.h>
@@ -169,6 +170,32 @@ QDomDocument fileToDomDoc( QString fileName, QString caller )
     return domDoc;
 }
 
+struct domCache_t
+{
+    QDateTime    modified;
+    qint64       size;
+    QDomDocument domDoc;
+};
+static QHash<QString, domCache_t> s_domCache;
+
+// Same as fileToDomDoc, but file is parsed again only if modified.
+// Returned document is shared: it must not be modified.
+QDomDocument cachedDomDoc( QString fileName, QString caller )
+{
+    QFileInfo fi( fileName );
+    QString path = fi.absoluteFilePath();
+
+    auto it = s_domCache.constFind( path );
+    if( it != s_domCache.constEnd()
+     && it->modified == fi.lastModified()
+     && it->size     == fi.size() ) return it->domDoc;
+
+    QDomDocument domDoc = fileToDomDoc( fileName, caller );
+    if( domDoc.isNull() ) s_domCache.remove( path );
+    else                  s_domCache[path] = { fi.lastModified(), fi.size(), domDoc };
+    return domDoc;
+}
+
 QString fileToString( QString fileName, QString caller )
 {
     QFile file( fileName );
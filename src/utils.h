@@ -72,6 +72,7 @@ QString findFile( QString dir, QString fileName );
 //---------------------------------------------------
 
 QDomDocument fileToDomDoc( QString fileName, QString caller );
+QDomDocument cachedDomDoc( QString fileName, QString caller );
 QString      fileToString( QString fileName, QString caller );
 QStringList  fileToStringList( QString fileName, QString caller );
 QByteArray   fileToByteArray( QString fileName, QString caller );